@@ -0,0 +1,450 @@
+#include "aot.hpp"
+
+#if LULU_AOT
+
+#include <dlfcn.h>  // dlopen, dlsym, dlclose, dlerror
+#include <stdarg.h> // va_list
+#include <stdio.h>  // vsnprintf
+
+//=== FINGERPRINTS ===================================================== {{{
+
+static u64
+hash_bytes(u64 h, const void *data, usize n)
+{
+    // 64-bit FNV-1a.
+    const u8 *bytes = static_cast<const u8 *>(data);
+    for (usize i = 0; i < n; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001b3;
+    }
+    return h;
+}
+
+/** @brief Undoes quickening, so that it does not change fingerprints. */
+static OpCode
+generic_op(OpCode op)
+{
+    switch (op) {
+    case OP_ADD_NUM:       return OP_ADD;
+    case OP_SUB_NUM:       return OP_SUB;
+    case OP_MUL_NUM:       return OP_MUL;
+    case OP_DIV_NUM:       return OP_DIV;
+    case OP_MOD_NUM:       return OP_MOD;
+    case OP_POW_NUM:       return OP_POW;
+    case OP_LT_NUM:        return OP_LT;
+    case OP_LEQ_NUM:       return OP_LEQ;
+    case OP_GET_TABLE_INT:
+    case OP_GET_TABLE_STR: return OP_GET_TABLE;
+    case OP_SET_TABLE_INT: return OP_SET_TABLE;
+    default:
+        return op;
+    }
+}
+
+/**
+ * @brief
+ *      Identifies `p` by everything the compiled code depends on: its
+ *      bytecode, constants and register usage. Children are not included,
+ *      as `OP_CLOSURE` is always left to the interpreter.
+ */
+static u64
+fingerprint(const Chunk *p)
+{
+    u64 h = 0xcbf29ce484222325;
+    for (Instruction i : p->code) {
+        i.set_op(generic_op(i.op()));
+        h = hash_bytes(h, &i.value, sizeof(i.value));
+    }
+
+    for (const Value &k : p->constants) {
+        Value_Type t = k.type();
+        h = hash_bytes(h, &t, sizeof(t));
+        switch (t) {
+        case VALUE_BOOLEAN: {
+            bool b = k.to_boolean();
+            h = hash_bytes(h, &b, sizeof(b));
+            break;
+        }
+        case VALUE_NUMBER: {
+            Number n = k.to_number();
+            h = hash_bytes(h, &n, sizeof(n));
+            break;
+        }
+        case VALUE_STRING: {
+            LString s = k.to_lstring();
+            h = hash_bytes(h, raw_data(s), static_cast<usize>(len(s)));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    u8 sizes[] = {p->n_params, p->n_upvalues, p->stack_used};
+    return hash_bytes(h, sizes, sizeof(sizes));
+}
+
+//=== }}} ==================================================================
+
+//=== CODE GENERATION ================================================== {{{
+
+struct Aot_Writer {
+    lulu_Writer writer;
+    void       *writer_data;
+
+    // First nonzero value returned by `writer`, after which nothing more is
+    // written.
+    int status;
+
+    // Number of functions written so far.
+    int n_functions;
+};
+
+[[gnu::format(printf, 2, 3)]] static void
+write_fmt(Aot_Writer *W, const char *fmt, ...)
+{
+    if (W->status != 0) {
+        return;
+    }
+
+    char    buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    usize size = min(static_cast<usize>(n), sizeof(buf) - 1);
+    W->status  = W->writer(W->writer_data, buf, size);
+}
+
+struct Aot_Operand {
+    char text[16];
+};
+
+/** @brief The C++ expression for `RK(reg)`. */
+static Aot_Operand
+rk(u16 reg)
+{
+    Aot_Operand o;
+    if (Instruction::reg_is_k(reg)) {
+        sprintf(o.text, "K[%u]", Instruction::reg_get_k(reg));
+    } else {
+        sprintf(o.text, "R[%u]", reg);
+    }
+    return o;
+}
+
+/** @return true if `op` is compiled, else false. */
+static bool
+is_compiled(OpCode op)
+{
+    switch (op) {
+    case OP_MOVE:
+    case OP_CONSTANT:
+    case OP_NIL:
+    case OP_BOOL:
+    case OP_GET_TABLE:
+    case OP_SET_TABLE:
+    case OP_GET_UPVALUE:
+    case OP_SET_UPVALUE:
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_DIV:
+    case OP_MOD:
+    case OP_POW:
+    case OP_EQ:
+    case OP_LT:
+    case OP_LEQ:
+    case OP_UNM:
+    case OP_NOT:
+    case OP_TEST:
+    case OP_TEST_SET:
+    case OP_JUMP:
+    case OP_JUMP_IF:
+    case OP_JUMP_IF_NOT:
+    case OP_FOR_LOOP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool
+has_compiled(const Chunk *p)
+{
+    for (Instruction i : p->code) {
+        if (is_compiled(generic_op(i.op()))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void
+write_instruction(Aot_Writer *W, const Chunk *p, int pc)
+{
+    Instruction i    = p->code[pc];
+    OpCode      op   = generic_op(i.op());
+    int         skip = pc + 2;
+    unsigned    a = i.a(), b = i.b();
+
+    write_fmt(W, "pc_%i: // %s\n", pc, opnames[op]);
+    switch (op) {
+    case OP_MOVE:
+        write_fmt(W, "    R[%u] = R[%u];\n", a, b);
+        break;
+    case OP_CONSTANT:
+        write_fmt(W, "    R[%u] = K[%u];\n", a, i.bx());
+        break;
+    case OP_NIL:
+        for (unsigned reg = a; reg <= b; reg++) {
+            write_fmt(W, "    R[%u] = nil;\n", reg);
+        }
+        break;
+    case OP_BOOL:
+        write_fmt(W, "    R[%u].set_boolean(%s);\n", a, b ? "true" : "false");
+        if (i.c() != 0) {
+            write_fmt(W, "    goto pc_%i;\n", skip);
+        }
+        break;
+    case OP_GET_UPVALUE:
+        write_fmt(W, "    R[%u] = *U[%u]->value;\n", a, b);
+        break;
+    case OP_SET_UPVALUE:
+        write_fmt(W, "    *U[%u]->value = R[%u];\n", b, a);
+        break;
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_DIV:
+    case OP_MOD:
+    case OP_POW:
+        write_fmt(W, "    if (!aot_%s(&R[%u], &%s, &%s)) return %i;\n",
+            opnames[op], a, rk(i.b()).text, rk(i.c()).text, pc);
+        break;
+    // The instruction at `pc + 1` is always `OP_JUMP`, which is only
+    // skipped when the comparison is not equal to A.
+    case OP_EQ:
+        write_fmt(W, "    if (%saot_eq(&%s, &%s)) goto pc_%i;\n",
+            a ? "!" : "", rk(i.b()).text, rk(i.c()).text, skip);
+        break;
+    case OP_LT:
+    case OP_LEQ:
+        write_fmt(W, "    switch (aot_%s(&%s, &%s)) {\n", opnames[op],
+            rk(i.b()).text, rk(i.c()).text);
+        write_fmt(W, "    case -1: return %i;\n", pc);
+        write_fmt(W, "    case %u: goto pc_%i;\n", a ? 0u : 1u, skip);
+        write_fmt(W, "    }\n");
+        break;
+    case OP_UNM:
+        write_fmt(W, "    if (!aot_unm(&R[%u], &R[%u])) return %i;\n",
+            a, b, pc);
+        break;
+    case OP_NOT:
+        write_fmt(W, "    R[%u].set_boolean(R[%u].is_falsy());\n", a, b);
+        break;
+    case OP_TEST:
+        write_fmt(W, "    if (%sR[%u].is_falsy()) goto pc_%i;\n",
+            i.c() ? "" : "!", a, skip);
+        break;
+    case OP_TEST_SET:
+        write_fmt(W, "    if (%sR[%u].is_falsy()) goto pc_%i;\n",
+            i.c() ? "" : "!", b, skip);
+        write_fmt(W, "    R[%u] = R[%u];\n", a, b);
+        break;
+    case OP_JUMP:
+        write_fmt(W, "    goto pc_%i;\n", pc + 1 + i.sbx());
+        break;
+    case OP_JUMP_IF:
+    case OP_JUMP_IF_NOT:
+        write_fmt(W, "    if (%sR[%u].is_falsy()) goto pc_%i;\n",
+            (op == OP_JUMP_IF) ? "!" : "", a, pc + 1 + i.sbx());
+        break;
+    case OP_FOR_LOOP:
+        write_fmt(W, "    if (aot_for_loop(&R[%u])) goto pc_%i;\n", a,
+            pc + 1 + i.sbx());
+        break;
+    case OP_GET_TABLE:
+        write_fmt(W, "    if (!aot_get_index(&R[%u], &R[%u], &%s)) "
+            "return %i;\n", a, b, rk(i.c()).text, pc);
+        break;
+    case OP_SET_TABLE:
+        write_fmt(W, "    if (!aot_set_index(&R[%u], &%s, &%s)) "
+            "return %i;\n", a, rk(i.b()).text, rk(i.c()).text, pc);
+        break;
+    default:
+        lulu_assert(!is_compiled(op));
+        write_fmt(W, "    return %i;\n", pc);
+        break;
+    }
+}
+
+/** @brief Calls `fn(W, p)` for `p` and all its descendants, in preorder. */
+template<class Fn>
+static void
+walk(Aot_Writer *W, const Chunk *p, Fn fn)
+{
+    fn(W, p);
+    for (const Chunk *child : p->children) {
+        walk(W, child, fn);
+    }
+}
+
+static void
+write_function(Aot_Writer *W, const Chunk *p)
+{
+    if (!has_compiled(p)) {
+        return;
+    }
+
+    Slice<Instruction> code = p->code;
+    write_fmt(W, "// %s:%i\n", p->source->to_cstring(), p->line_defined);
+    write_fmt(W, "static u32\n");
+    write_fmt(W, "function_%i(lulu_VM *, const Closure_Lua *f, "
+        "[[maybe_unused]] Value *R,\n    u32 pc)\n", W->n_functions++);
+    write_fmt(W, "{\n");
+    write_fmt(W, "    [[maybe_unused]] Upvalue *const *U = f->upvalues;\n");
+    write_fmt(W, "    [[maybe_unused]] const Value *K = "
+        "raw_data(f->chunk->constants);\n\n");
+
+    write_fmt(W, "    switch (pc) {\n");
+    for (int pc = 0; pc < len(code); pc++) {
+        if (is_compiled(generic_op(code[pc].op()))) {
+            write_fmt(W, "    case %i: goto pc_%i;\n", pc, pc);
+        }
+        // The instructions after `OP_CLOSURE` only describe its upvalues.
+        if (code[pc].op() == OP_CLOSURE) {
+            pc += p->children[code[pc].bx()]->n_upvalues;
+        }
+    }
+    write_fmt(W, "    default: return pc;\n");
+    write_fmt(W, "    }\n\n");
+
+    for (int pc = 0; pc < len(code); pc++) {
+        write_instruction(W, p, pc);
+        if (code[pc].op() == OP_CLOSURE) {
+            pc += p->children[code[pc].bx()]->n_upvalues;
+        }
+    }
+    write_fmt(W, "}\n\n");
+}
+
+static void
+write_entry(Aot_Writer *W, const Chunk *p)
+{
+    if (!has_compiled(p)) {
+        return;
+    }
+    unsigned long long fp = fingerprint(p);
+    write_fmt(W, "    {%#018llxull, function_%i},\n", fp, W->n_functions++);
+}
+
+int
+aot_dump(const Chunk *p, lulu_Writer writer, void *writer_data)
+{
+    Aot_Writer W{writer, writer_data, 0, 0};
+    write_fmt(&W, "// Generated by `lulu_dump_aot()` from \"%s\". "
+        "Do not edit.\n", p->source->to_cstring());
+    write_fmt(&W, "//\n");
+    write_fmt(&W, "// Build against the same headers and configuration as the "
+        "library, e.g.:\n");
+    write_fmt(&W, "//\n");
+    write_fmt(&W, "//     c++ -std=c++17 -O2 -DLULU_BUILD_ALL -nostdinc++ "
+        "-I<lulu>/cpp/src\n");
+    write_fmt(&W, "//         -shared -fPIC -o script.so script.cpp\n");
+    write_fmt(&W, "//\n");
+    write_fmt(&W, "// Then load it with `lulu_load_aot()`, e.g. "
+        "`lulu --native script.so script.lua`.\n");
+    write_fmt(&W, "#include \"aot.hpp\"\n\n");
+    write_fmt(&W, "#pragma GCC diagnostic ignored \"-Wunused-label\"\n\n");
+
+    walk(&W, p, write_function);
+
+    int n = W.n_functions;
+    W.n_functions = 0;
+    if (n > 0) {
+        write_fmt(&W, "static const Aot_Entry entries[] = {\n");
+        walk(&W, p, write_entry);
+        write_fmt(&W, "};\n\n");
+    }
+    write_fmt(&W, "extern \"C\" LULU_PUBLIC const Aot_Module %s = {\n",
+        AOT_MODULE_NAME);
+    write_fmt(&W, "    AOT_VERSION, sizeof(Value), %s, %i,\n",
+        (n > 0) ? "entries" : "nullptr", n);
+    write_fmt(&W, "};\n");
+    return W.status;
+}
+
+//=== }}} ==================================================================
+
+//=== LOADING ========================================================== {{{
+
+static const Aot_Module *
+module_get(void *library)
+{
+    return static_cast<const Aot_Module *>(dlsym(library, AOT_MODULE_NAME));
+}
+
+void
+aot_open(lulu_VM *L, const char *file_name)
+{
+    Dynamic<void *> *libraries = &G(L)->aot_libraries;
+
+    // Make room first, so that a memory error cannot leak the library.
+    dynamic_resize(L, libraries, len(*libraries) + 1);
+    dynamic_pop(libraries);
+
+    void *library = dlopen(file_name, RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) {
+        vm_runtime_error(L, "%s", dlerror());
+    }
+
+    const Aot_Module *m = module_get(library);
+    if (m == nullptr || m->version != AOT_VERSION
+        || m->value_size != sizeof(Value))
+    {
+        dlclose(library);
+        vm_runtime_error(L, "Library '%s' was not generated by this version of "
+            "lulu_dump_aot()", file_name);
+    }
+    dynamic_push(L, libraries, library);
+}
+
+void
+aot_bind(lulu_VM *L, Chunk *p)
+{
+    Slice<void *> libraries = G(L)->aot_libraries;
+    if (len(libraries) == 0) {
+        return;
+    }
+
+    u64 fp = fingerprint(p);
+    for (void *library : libraries) {
+        const Aot_Module *m = module_get(library);
+        for (isize i = 0; i < m->n_entries; i++) {
+            if (m->entries[i].fingerprint == fp) {
+                p->aot = m->entries[i].function;
+                break;
+            }
+        }
+    }
+
+    for (Chunk *child : p->children) {
+        aot_bind(L, child);
+    }
+}
+
+void
+aot_close(lulu_VM *L)
+{
+    Dynamic<void *> *libraries = &G(L)->aot_libraries;
+    for (void *library : *libraries) {
+        dlclose(library);
+    }
+    dynamic_delete(L, *libraries);
+}
+
+//=== }}} ==================================================================
+
+#endif // LULU_AOT
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "chunk.hpp"
+#include "function.hpp"
+#include "table.hpp"
+#include "vm.hpp"
+
+#if LULU_AOT
+
+/**
+ * @brief
+ *      Ahead-of-time compilation of Lua functions to C++.
+ *
+ * @details
+ *      `aot_dump()` writes out each function as a single C++ function of
+ *      type `Aot_Function`, with one label per instruction. Instructions
+ *      which can never throw, call or allocate, e.g. moves, arithmetic on
+ *      numbers, comparisons and jumps, are translated to the inline helpers
+ *      below. Every other instruction, and any of the former whose operands
+ *      are not of the expected types, returns its pc so that the
+ *      interpreter runs it instead.
+ *
+ *      This header is included by the generated code, so everything it
+ *      uses must be inline: the rest of the library is not visible to it.
+ *
+ *      Functions are matched to the code generated from them by
+ *      fingerprint, i.e. a hash of their bytecode and constants, so a
+ *      changed script simply falls back to being interpreted.
+ */
+
+// Changed whenever the generated code would no longer work with this header.
+#define AOT_VERSION 1
+
+// The only symbol which generated libraries export.
+#define AOT_MODULE_NAME "lulu_aot_module"
+
+struct Aot_Entry {
+    u64          fingerprint;
+    Aot_Function function;
+};
+
+struct Aot_Module {
+    u32 version;
+
+    // `sizeof(Value)` in the generated code, which differs if it was built
+    // with a different `LULU_NAN_BOXING`.
+    u32 value_size;
+
+    const Aot_Entry *entries;
+    isize            n_entries;
+};
+
+/**
+ * @return
+ *      0 on success, or the first nonzero value returned by `writer`.
+ */
+int
+aot_dump(const Chunk *p, lulu_Writer writer, void *writer_data);
+
+/** @brief Implements `lulu_load_aot()`. */
+void
+aot_open(lulu_VM *L, const char *file_name);
+
+/** @brief Binds `p` and its children to compiled code, if there is any. */
+void
+aot_bind(lulu_VM *L, Chunk *p);
+
+/** @brief Unloads every library loaded by `aot_open()`. */
+void
+aot_close(lulu_VM *L);
+
+/**
+ * @brief
+ *      Runs the compiled code of `f`, which must exist, from `ip`.
+ *
+ * @return
+ *      Where the interpreter must continue from. This is `ip` itself if
+ *      the instruction there was not compiled.
+ */
+inline const Instruction *
+aot_run(lulu_VM *L, const Closure_Lua *f, Value *base, const Instruction *ip)
+{
+    const Chunk       *p    = f->chunk;
+    const Instruction *code = raw_data(p->code);
+    u32                pc   = static_cast<u32>(ip - code);
+    return code + p->aot(L, f, base, pc);
+}
+
+//=== HELPERS FOR GENERATED CODE ======================================= {{{
+
+// Each of these does exactly what `vm_execute()` would for operands of the
+// expected types. Otherwise they return false (or -1) without doing anything.
+
+/**
+ * @brief
+ *      `fmod()` of integers is their remainder, except that it is `-0` when a
+ *      negative dividend is divisible and NaN when dividing by 0.
+ */
+inline bool
+aot_integer_mod(Integer a, Integer b, Integer *r)
+{
+    if (b == 0) {
+        return false;
+    }
+    *r = a % b;
+    return *r != 0 || a >= 0;
+}
+
+#define AOT_ARITH_INT(name, int_fn, number_fn)                                 \
+inline bool                                                                    \
+aot_##name(Value *ra, const Value *rb, const Value *rc)                        \
+{                                                                              \
+    Integer r;                                                                 \
+    if (rb->is_integer() && rc->is_integer()                                   \
+        && int_fn(rb->to_integer(), rc->to_integer(), &r))                     \
+    {                                                                          \
+        ra->set_integer(r);                                                    \
+        return true;                                                           \
+    }                                                                          \
+    if (!rb->is_number() || !rc->is_number()) {                                \
+        return false;                                                          \
+    }                                                                          \
+    ra->set_number(number_fn(rb->to_number(), rc->to_number()));               \
+    return true;                                                               \
+}
+
+#define AOT_ARITH(name, number_fn)                                             \
+inline bool                                                                    \
+aot_##name(Value *ra, const Value *rb, const Value *rc)                        \
+{                                                                              \
+    if (!rb->is_number() || !rc->is_number()) {                                \
+        return false;                                                          \
+    }                                                                          \
+    ra->set_number(number_fn(rb->to_number(), rc->to_number()));               \
+    return true;                                                               \
+}
+
+#define AOT_COMPARE(name, op, number_fn)                                       \
+inline int                                                                     \
+aot_##name(const Value *rb, const Value *rc)                                   \
+{                                                                              \
+    if (rb->is_integer() && rc->is_integer()) {                                \
+        return rb->to_integer() op rc->to_integer();                           \
+    }                                                                          \
+    if (!rb->is_number() || !rc->is_number()) {                                \
+        return -1;                                                             \
+    }                                                                          \
+    return number_fn(rb->to_number(), rc->to_number());                        \
+}
+
+AOT_ARITH_INT(add, integer_add, lulu_Number_add)
+AOT_ARITH_INT(sub, integer_sub, lulu_Number_sub)
+AOT_ARITH_INT(mul, integer_mul, lulu_Number_mul)
+AOT_ARITH_INT(mod, aot_integer_mod, lulu_Number_mod)
+AOT_ARITH(div, lulu_Number_div)
+AOT_ARITH(pow, lulu_Number_pow)
+AOT_COMPARE(lt, <, lulu_Number_lt)
+AOT_COMPARE(leq, <=, lulu_Number_leq)
+
+#undef AOT_ARITH_INT
+#undef AOT_ARITH
+#undef AOT_COMPARE
+
+inline bool
+aot_unm(Value *ra, const Value *rb)
+{
+    if (!rb->is_number()) {
+        return false;
+    }
+    ra->set_number(lulu_Number_unm(rb->to_number()));
+    return true;
+}
+
+/** @brief Raw equality, as `Value::operator==()` is not inline. */
+inline bool
+aot_eq(const Value *a, const Value *b)
+{
+    if (a->is_number() && b->is_number()) {
+        return lulu_Number_eq(a->to_number(), b->to_number());
+    } else if (a->type() != b->type()) {
+        return false;
+    }
+
+    switch (a->type()) {
+    case VALUE_NIL:
+        return true;
+    case VALUE_BOOLEAN:
+        return a->to_boolean() == b->to_boolean();
+    case VALUE_LIGHTUSERDATA:
+        return a->to_lightuserdata() == b->to_lightuserdata();
+    default:
+        return a->to_object() == b->to_object();
+    }
+}
+
+/** @return true if the loop continues, in which case the caller jumps. */
+inline bool
+aot_for_loop(Value *ra)
+{
+    if (ra[0].is_integer()) {
+        Integer limit = ra[1].to_integer();
+        Integer incr  = ra[2].to_integer();
+        Integer next  = ra[0].to_integer() + incr;
+        if ((0 < incr) ? (next <= limit) : (limit <= next)) {
+            ra[0].set_integer(next);
+            ra[3].set_integer(next);
+            return true;
+        }
+        return false;
+    }
+
+    Number limit = ra[1].to_number();
+    Number incr  = ra[2].to_number();
+    Number next  = lulu_Number_add(ra[0].to_number(), incr);
+    if (lulu_Number_lt(0, incr) ? lulu_Number_leq(next, limit)
+                                : lulu_Number_leq(limit, next))
+    {
+        ra[0].set_number(next);
+        ra[3].set_number(next);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @return
+ *      The slot `t[k]` in the array segment of `t`, or `nullptr` if `t` is
+ *      not a table or `k` is not an index in its array segment.
+ */
+inline Value *
+aot_array_slot(const Value *t, const Value *k)
+{
+    if (!t->is_table() || !k->is_number()) {
+        return nullptr;
+    }
+
+    Table  *tt = t->to_table();
+    Integer i;
+    if (k->is_integer()) {
+        i = k->to_integer();
+    } else if (!number_to_integer(k->to_number(), &i)) {
+        return nullptr;
+    }
+    if (1 <= i && i <= len(tt->array)) {
+        return &tt->array[i - 1];
+    }
+    return nullptr;
+}
+
+/** @brief `R(A) := R(B)[RK(C)]` for array indices without `__index`. */
+inline bool
+aot_get_index(Value *ra, const Value *t, const Value *k)
+{
+    const Value *v = aot_array_slot(t, k);
+    if (v == nullptr || (v->is_nil() && t->to_table()->metatable != nullptr)) {
+        return false;
+    }
+    *ra = *v;
+    return true;
+}
+
+/** @brief `R(A)[RK(B)] := RK(C)` for array indices without `__newindex`. */
+inline bool
+aot_set_index(const Value *t, const Value *k, const Value *v)
+{
+    Value *dst = aot_array_slot(t, k);
+    if (dst == nullptr
+        || (dst->is_nil() && t->to_table()->metatable != nullptr))
+    {
+        return false;
+    }
+    // luaC_barriert(L, t, v);
+    *dst = *v;
+    return true;
+}
+
+//=== }}} ==================================================================
+
+#endif // LULU_AOT
@@ -1,3 +1,4 @@
+#include "aot.hpp"
 #include "stream.hpp"
 #include "vm.hpp"
 
@@ -71,6 +72,33 @@ lulu_load(lulu_VM *L, const char *source, lulu_Reader reader,
     return e;
 }
 
+LULU_API int
+lulu_dump_aot(lulu_VM *L, lulu_Writer writer, void *writer_data)
+{
+#if LULU_AOT
+    const Value *v = value_at(L, -1);
+    if (!v->is_function() || !v->to_function()->is_lua()) {
+        return 1;
+    }
+    return aot_dump(v->to_function()->lua.chunk, writer, writer_data);
+#else // ^^^ LULU_AOT, vvv otherwise
+    unused(L);
+    unused(writer);
+    unused(writer_data);
+    return 1;
+#endif // LULU_AOT
+}
+
+LULU_API void
+lulu_load_aot(lulu_VM *L, const char *file_name)
+{
+#if LULU_AOT
+    aot_open(L, file_name);
+#else // ^^^ LULU_AOT, vvv otherwise
+    vm_runtime_error(L, "Cannot load '%s': built without LULU_AOT", file_name);
+#endif // LULU_AOT
+}
+
 LULU_API void
 lulu_call(lulu_VM *L, int n_args, int n_rets)
 {
@@ -137,6 +165,34 @@ lulu_error(lulu_VM *L)
     return 0;
 }
 
+LULU_API lulu_VM *
+lulu_new_thread(lulu_VM *L)
+{
+    return thread_new(L);
+}
+
+LULU_API lulu_Error
+lulu_status(lulu_VM *L)
+{
+    return L->status;
+}
+
+LULU_API void
+lulu_xmove(lulu_VM *from, lulu_VM *to, int n)
+{
+    if (from == to) {
+        return;
+    }
+    lulu_assert(G(from) == G(to));
+    lulu_assert(0 <= n && n <= len(from->window));
+
+    Value *args = vm_ptr_top(from) - n;
+    for (Value v : slice_pointer_len(args, n)) {
+        vm_push_value(to, v);
+    }
+    from->window.len -= n;
+}
+
 /*=== TYPE QUERY FUNCTIONS ========================================== {{{ */
 
 LULU_API lulu_Type
@@ -258,6 +314,23 @@ lulu_to_pointer(lulu_VM *L, int i)
     return value_at(L, i)->to_pointer();
 }
 
+LULU_API lulu_VM *
+lulu_to_thread(lulu_VM *L, int i)
+{
+    const Value *v = value_at(L, i);
+    return v->is_thread() ? v->to_thread() : nullptr;
+}
+
+LULU_API int
+lulu_check_stack(lulu_VM *L, int n)
+{
+    if (vm_save_top(L) + n > MAX_STACK) {
+        return 0;
+    }
+    vm_check_stack(L, n);
+    return 1;
+}
+
 LULU_API int
 lulu_get_top(lulu_VM *L)
 {
@@ -335,7 +408,7 @@ lulu_push_number(lulu_VM *L, lulu_Number n)
 LULU_API void
 lulu_push_integer(lulu_VM *L, lulu_Integer i)
 {
-    vm_push_value(L, Value::make_number(static_cast<Number>(i)));
+    vm_push_value(L, Value::make_integral(i));
 }
 
 LULU_API void
@@ -397,6 +470,14 @@ lulu_push_cclosure(lulu_VM *L, lulu_CFunction cf, int n_upvalues)
     vm_push_value(L, f->c.to_value());
 }
 
+LULU_API void
+lulu_push_light_function(lulu_VM *L, lulu_CFunction cf)
+{
+    Closure *f    = closure_c_new(L, cf, 0);
+    f->c.is_light = true;
+    vm_push_value(L, f->c.to_value());
+}
+
 LULU_API void
 lulu_push_value(lulu_VM *L, int i)
 {
@@ -404,6 +485,13 @@ lulu_push_value(lulu_VM *L, int i)
     vm_push_value(L, *v);
 }
 
+LULU_API int
+lulu_push_thread(lulu_VM *L)
+{
+    vm_push_value(L, Value::make_thread(L));
+    return L == G(L)->main_thread;
+}
+
 /*=== }}} =============================================================== */
 
 
@@ -2,6 +2,7 @@
 
 #include "chunk.hpp"
 #include "debug.hpp"
+#include "jit.hpp"
 #include "object.hpp"
 #include "vm.hpp"
 
@@ -11,6 +12,9 @@ chunk_new(lulu_VM *L, OString *source)
     Chunk *p = object_new<Chunk>(L, &G(L)->objects, VALUE_CHUNK);
     p->source     = source;
     p->stack_used = 2; // R(0) and R(1) must always be valid.
+#if LULU_JIT
+    p->jit_hotness = LULU_JIT_THRESHOLD;
+#endif // LULU_JIT
     return p;
 }
 
@@ -23,6 +27,10 @@ chunk_delete(lulu_VM *L, Chunk *p)
     slice_delete(L, p->children);
     slice_delete(L, p->code);
     slice_delete(L, p->lines);
+    slice_delete(L, p->field_cache);
+#if LULU_JIT
+    jit_free(p);
+#endif // LULU_JIT
     mem_free(L, p);
 }
 
@@ -5,6 +5,18 @@
 #include "string.hpp"
 #include "value.hpp"
 
+#if LULU_JIT
+struct Jit_Code;
+#endif // LULU_JIT
+
+struct Closure_Lua;
+
+#if LULU_AOT
+// Compiled ahead of time by `lulu_dump_aot()`. See `aot.hpp`.
+using Aot_Function = u32 (*)(lulu_VM *L, const Closure_Lua *f, Value *base,
+    u32 pc);
+#endif // LULU_AOT
+
 struct Line_Info {
     int line; // Line number is stored directly in case we skip empty lines.
     int start_pc;
@@ -48,6 +60,29 @@ struct Chunk : Object_Header {
     // Maps bytecode indices to source code lines.
     Slice<Line_Info> lines;
 
+    // Inline caches for `OP_GET_FIELD`, `OP_SET_FIELD`, `OP_GET_GLOBAL` and
+    // `OP_SET_GLOBAL`, indexed by pc. Each holds the index in `Table::entries`
+    // where the instruction last found its key. Empty if the chunk has no
+    // such instructions.
+    Slice<u32> field_cache;
+
+    // The closure last created from this chunk by `OP_CLOSURE`, which it
+    // reuses instead if it would capture the same upvalues. This is a weak
+    // reference: the GC clears it if nothing else keeps the closure alive.
+    Closure_Lua *cache;
+
+#if LULU_JIT
+    // Native code generated once `jit_hotness` counts down to 0, or `nullptr`
+    // if there is none yet. See `jit.hpp`.
+    Jit_Code *jit;
+    int       jit_hotness;
+#endif // LULU_JIT
+
+#if LULU_AOT
+    // Found in a library loaded by `lulu_load_aot()`, or `nullptr`.
+    Aot_Function aot;
+#endif // LULU_AOT
+
     // Debug/VM information
     OString *source;
     int line_defined;
@@ -55,6 +90,11 @@ struct Chunk : Object_Header {
     u8 n_upvalues;
     u8 n_params;
     u8 stack_used;
+
+    // Registers `[0, stack_cleared)` which, other than the parameters, must be
+    // `nil` on entry. The compiler ensures every register after these is
+    // written to before it is read, so calls need not clear them.
+    u8 stack_cleared;
 };
 
 static constexpr u16 VARARG  = Instruction::MAX_B;
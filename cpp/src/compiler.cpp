@@ -19,6 +19,9 @@ jump_get_control(Compiler *c, int jump_pc);
 static int
 jump_if(Compiler *c, OpCode op, u16 a, u16 b, u16 c2);
 
+static int
+jump_if_reg(Compiler *c, u16 reg, bool cond);
+
 void
 compiler_error_limit(Compiler *c, int limit, const char *what)
 {
@@ -92,6 +95,11 @@ compiler_load_nil(Compiler *c, u16 reg, int n)
         if (pc == 0) {
             // Target register is a new local?
             if (static_cast<isize>(reg) >= small_array_len(c->active)) {
+                Chunk *p = c->chunk;
+                u16    n = last_reg + 1;
+                if (n > p->stack_cleared) {
+                    p->stack_cleared = static_cast<u8>(n);
+                }
                 return;
             }
             // Target register is an existing local.
@@ -126,8 +134,8 @@ add_constant(Compiler *c, Value k, Value v)
 {
     const Value i = table_get(c->indexes, k);
     // Constant found and is not a string literal mapping to true?
-    if (i.is_integer()) {
-        return static_cast<u32>(i.to_integer());
+    if (i.is_number()) {
+        return static_cast<u32>(i.to_number());
     }
 
     lulu_VM *L = c->L;
@@ -141,10 +149,22 @@ add_constant(Compiler *c, Value k, Value v)
     return n;
 }
 
+/** @brief Integral constants are stored in integer form so that e.g.
+ *  `t[i + 1]` can keep `i + 1` in integer form as well. */
+static Value
+number_constant(Number n)
+{
+    Integer i;
+    if (number_to_exact_integer(n, &i)) {
+        return Value::make_integer(i);
+    }
+    return Value::make_number(n);
+}
+
 u32
 compiler_add_number(Compiler *c, Number n)
 {
-    Value v = Value::make_number(n);
+    Value v = number_constant(n);
     return add_constant(c, v, v);
 }
 
@@ -218,11 +238,13 @@ discharge_vars(Compiler *c, Expr *e)
         // locals are already in registers
         e->type = EXPR_DISCHARGED;
         break;
-    case EXPR_INDEXED: {
-        u16 t   = e->table.reg;
-        u16 k   = e->table.field_rk;
-        e->type = EXPR_RELOCABLE;
-        e->pc   = compiler_code_abc(c, OP_GET_TABLE, NO_REG, t, k);
+    case EXPR_INDEXED:
+    case EXPR_FIELD: {
+        OpCode op = (e->type == EXPR_FIELD) ? OP_GET_FIELD : OP_GET_TABLE;
+        u16    t  = e->table.reg;
+        u16    k  = e->table.field_rk;
+        e->type   = EXPR_RELOCABLE;
+        e->pc     = compiler_code_abc(c, op, NO_REG, t, k);
         // We can reuse these registers as they're no longer needed (for now).
         pop_reg(c, k);
         pop_reg(c, t);
@@ -402,7 +424,7 @@ compiler_expr_rk(Compiler *c, Expr *e)
     case EXPR_NIL:    return value_to_rk(c, e, nil);
     case EXPR_FALSE:  return value_to_rk(c, e, Value::make_boolean(true));
     case EXPR_TRUE:   return value_to_rk(c, e, Value::make_boolean(false));
-    case EXPR_NUMBER: return value_to_rk(c, e, Value::make_number(e->number));
+    case EXPR_NUMBER: return value_to_rk(c, e, number_constant(e->number));
 
     // May reach here if we previously called this.
     case EXPR_CONSTANT:
@@ -664,11 +686,13 @@ compiler_set_variable(Compiler *c, Expr *restrict var, Expr *restrict expr)
         expr_to_reg(c, expr, var->reg);
         break;
     }
-    case EXPR_INDEXED: {
-        u16 t = var->table.reg;
-        u16 k = var->table.field_rk;
-        u16 v = compiler_expr_rk(c, expr);
-        compiler_code_abc(c, OP_SET_TABLE, t, k, v);
+    case EXPR_INDEXED:
+    case EXPR_FIELD: {
+        OpCode op = (var->type == EXPR_FIELD) ? OP_SET_FIELD : OP_SET_TABLE;
+        u16    t  = var->table.reg;
+        u16    k  = var->table.field_rk;
+        u16    v  = compiler_expr_rk(c, expr);
+        compiler_code_abc(c, op, t, k, v);
         break;
     }
     case EXPR_UPVALUE: {
@@ -729,6 +753,14 @@ compiler_set_one_return(Compiler *c, Expr *e)
     }
 }
 
+void
+compiler_set_tail_call(Compiler *c, Expr *call)
+{
+    lulu_assert(call->type == EXPR_CALL);
+    Instruction *ip = get_code(c, call->pc);
+    ip->set_op(OP_TAIL_CALL);
+}
+
 u16
 compiler_get_local(Compiler *c, u16 limit, OString *ident)
 {
@@ -748,8 +780,14 @@ compiler_get_local(Compiler *c, u16 limit, OString *ident)
 void
 compiler_get_table(Compiler *c, Expr *restrict t, Expr *restrict k)
 {
-    u16 rkb           = compiler_expr_rk(c, k);
-    t->type           = EXPR_INDEXED;
+    u16 rkb = compiler_expr_rk(c, k);
+
+    // Constant string keys, e.g. `t.k` or `t["k"]`, get their own opcodes
+    // so that they can use the inline cache in `Chunk::field_cache`.
+    bool is_field = Instruction::reg_is_k(rkb)
+        && c->chunk->constants[Instruction::reg_get_k(rkb)].is_string();
+
+    t->type           = (is_field) ? EXPR_FIELD : EXPR_INDEXED;
     t->table.reg      = t->reg;
     t->table.field_rk = rkb;
 }
@@ -915,8 +953,14 @@ compiler_jump_patch(Compiler *c, int jump_pc, int target, u16 reg)
     }
 }
 
+/**
+ * @param fuse
+ *      The value of `left` is never needed, so a register test can be
+ *      emitted as a single `OP_JUMP_IF{_NOT}` instead of an
+ *      `OP_TEST{_SET}`-`OP_JUMP` pair.
+ */
 static int
-logical_target_get(Compiler *c, Expr *left, bool cond)
+logical_target_get(Compiler *c, Expr *left, bool cond, bool fuse)
 {
     discharge_vars(c, left);
     switch (left->type) {
@@ -960,12 +1004,18 @@ logical_target_get(Compiler *c, Expr *left, bool cond)
         if (ip.op() == OP_NOT) {
             // Remove previous `OP_NOT`, replace it with a jump-test pair.
             code_pop(c);
+            if (fuse) {
+                return jump_if_reg(c, ip.b(), cond);
+            }
             return jump_if(c, OP_TEST, ip.b(), 0, static_cast<u16>(cond));
         }
     }
 
     u16 rb = discharge_any_reg(c, left);
     pop_expr(c, left);
+    if (fuse) {
+        return jump_if_reg(c, rb, !cond);
+    }
     return jump_if(c, OP_TEST_SET, NO_REG, rb, static_cast<u16>(!cond));
 }
 
@@ -983,10 +1033,18 @@ jump_if(Compiler *c, OpCode op, u16 a, u16 b, u16 c2)
     return compiler_jump_new(c);
 }
 
-void
-compiler_logical_new(Compiler *c, Expr *left, bool cond)
+/** @brief Emits a jump which is taken when `Bool(R(reg)) == cond`. */
+static int
+jump_if_reg(Compiler *c, u16 reg, bool cond)
+{
+    OpCode op = (cond) ? OP_JUMP_IF : OP_JUMP_IF_NOT;
+    return compiler_code_asbx(c, op, reg, NO_JUMP);
+}
+
+static void
+logical_new(Compiler *c, Expr *left, bool cond, bool fuse)
 {
-    int jump_pc = logical_target_get(c, left, cond);
+    int jump_pc = logical_target_get(c, left, cond, fuse);
     if (cond) {
         // logical-and
         // Falsy patch list may be non-empty.
@@ -1006,6 +1064,18 @@ compiler_logical_new(Compiler *c, Expr *left, bool cond)
     }
 }
 
+void
+compiler_logical_new(Compiler *c, Expr *left, bool cond)
+{
+    logical_new(c, left, cond, /*fuse=*/false);
+}
+
+void
+compiler_condition(Compiler *c, Expr *e)
+{
+    logical_new(c, e, /*cond=*/true, /*fuse=*/true);
+}
+
 void
 compiler_logical_patch(Compiler *c, Expr *restrict left, Expr *restrict right,
     bool cond)
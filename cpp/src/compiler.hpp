@@ -249,6 +249,16 @@ void
 compiler_set_one_return(Compiler *c, Expr *e);
 
 
+/** @brief Turns the `OP_CALL` of `call` into an `OP_TAIL_CALL`.
+ *
+ * @note(2025-09-16)
+ *      Only valid for the sole expression in a `return` statement, and only
+ *      after its returns were already set to `VARARG`.
+ */
+void
+compiler_set_tail_call(Compiler *c, Expr *call);
+
+
 /** @brief Finds the index of local variable represented by `ident`, searching
  *  only up to the `limit`-th active local.
  *
@@ -333,6 +343,21 @@ compiler_jump_patch(Compiler *c, int jump_pc, int target = NO_JUMP,
 void
 compiler_logical_new(Compiler *c, Expr *left, bool cond);
 
+
+/** @brief Like `compiler_logical_new(c, e, true)` for the condition of an
+ *  `if`, `elseif`, `while` or `until`, whose value is only ever tested.
+ *
+ * @details
+ *      A test of a register is emitted as a single `OP_JUMP_IF{_NOT}`
+ *      rather than an `OP_TEST_SET` which is later patched into `OP_TEST`.
+ *      Comparisons are still followed by an `OP_JUMP`, as their two RK
+ *      operands leave no room for a jump offset.
+ *
+ *      The falsy jump list is in `e->patch_false`.
+ */
+void
+compiler_condition(Compiler *c, Expr *e);
+
 void
 compiler_logical_patch(Compiler *c, Expr *restrict left, Expr *restrict right,
     bool cond);
@@ -150,7 +150,8 @@ debug_disassemble_at(const Chunk *p, Instruction ip, int pc, int pad)
         break;
     }
 
-    switch (op) {
+    // Quickened opcodes have the exact same operands as their generic ones.
+    switch (opcode_generic(op)) {
     case OP_MOVE:
         print_reg(p, args.a, pc, " := ");
         print_reg(p, args.b, pc);
@@ -193,11 +194,13 @@ debug_disassemble_at(const Chunk *p, Instruction ip, int pc, int pad)
         break;
     }
     case OP_GET_TABLE:
+    case OP_GET_FIELD:
         print_reg(p, args.a, pc, " := ");
         print_reg(p, args.b, pc, "[");
         print_reg(p, args.c, pc, "]");
         break;
     case OP_SET_TABLE:
+    case OP_SET_FIELD:
         print_reg(p, args.a, pc, "[");
         print_reg(p, args.b, pc, "] := ");
         print_reg(p, args.c, pc);
@@ -278,7 +281,15 @@ debug_disassemble_at(const Chunk *p, Instruction ip, int pc, int pad)
         printf("ip += %i ; goto .code[%i]", offset, jump_resolve(pc, offset));
         break;
     }
-    case OP_CALL: {
+    case OP_JUMP_IF:
+    case OP_JUMP_IF_NOT: {
+        printf("goto .code[%i if %s", jump_resolve(pc, args.sbx),
+            (op == OP_JUMP_IF) ? "" : "not ");
+        print_reg(p, args.a, pc, " else %i]", jump_resolve(pc, 0));
+        break;
+    }
+    case OP_CALL:
+    case OP_CALL_MATH: {
         u16 argc = args.b;
         u16 retc = args.c;
 
@@ -301,6 +312,19 @@ debug_disassemble_at(const Chunk *p, Instruction ip, int pc, int pad)
         }
         break;
     }
+    case OP_TAIL_CALL: {
+        u16 argc      = args.b;
+        u16 first_arg = args.a + 1;
+        printf("return R(%u)", args.a);
+        if (argc == 0) {
+            printf("()");
+        } else if (argc == VARARG) {
+            printf("(R(%u:))", first_arg);
+        } else {
+            printf("(R(%u:%u))", first_arg, first_arg + argc);
+        }
+        break;
+    }
     case OP_SELF:
         print_reg(p, args.a + 1, pc, " := ");
         print_reg(p, args.b, pc, "; ");
@@ -324,6 +348,9 @@ debug_disassemble_at(const Chunk *p, Instruction ip, int pc, int pad)
             printf("R(%u:%u)", args.a, args.a + args.b);
         }
         break;
+    default:
+        lulu_unreachable();
+        break;
     }
 
     printf("\n");
@@ -334,6 +361,7 @@ debug_disassemble(const Chunk *p)
 {
     printf("\n=== DISASSEMBLY: BEGIN ===\n");
     printf(".stack_used %i\n", p->stack_used);
+    printf(".stack_cleared %i\n", p->stack_cleared);
 
     int n = static_cast<int>(len(p->locals));
     if (n > 0) {
@@ -499,7 +527,7 @@ get_obj_name(lulu_VM *L, Call_Frame *cf, int reg, const char **ident)
             return "local";
         }
         Instruction i = get_variable_ip(p, pc, reg);
-        switch (i.op()) {
+        switch (opcode_generic(i.op())) {
         // Concept check: `local f; f()`
         case OP_MOVE: {
             u16 a = i.a();
@@ -513,6 +541,7 @@ get_obj_name(lulu_VM *L, Call_Frame *cf, int reg, const char **ident)
             *ident = p->constants[i.bx()].to_cstring();
             return "global";
         case OP_GET_TABLE:
+        case OP_GET_FIELD:
             *ident = get_rk_name(p, i.c()); // RK(C) is the desired field.
             return "field";
         case OP_SELF:
@@ -610,16 +639,26 @@ get_current_pc(lulu_VM *L, Call_Frame *cf)
 static const char *
 get_func_name(lulu_VM *L, Call_Frame *cf, const char **name)
 {
-    // The parent caller of this function MUST be lua.
-    if (!(cf - 1)->is_lua()) {
+    // The parent caller of this function MUST be lua. If we were tail
+    // called, its current instruction called someone else entirely.
+    // A coroutine's main function has no parent caller at all.
+    if (cf == raw_data(L->frames) || !(cf - 1)->is_lua()
+        || cf->is_tail_call)
+    {
         return nullptr;
     }
     // Point to parent caller (the call*ing* function).
     cf--;
     int         pc = get_current_pc(L, cf);
     Instruction i  = cf->to_lua()->chunk->code[pc];
-    if (i.op() == OP_CALL || i.op() == OP_FOR_IN) {
+    switch (i.op()) {
+    case OP_CALL:
+    case OP_CALL_MATH:
+    case OP_TAIL_CALL:
+    case OP_FOR_IN:
         return get_obj_name(L, cf, i.a(), name);
+    default:
+        break;
     }
     // No useful name can be found.
     return nullptr;
@@ -674,8 +713,8 @@ get_info(lulu_VM *L, const char *options, lulu_Debug *ar, Closure *f,
 LULU_API int
 lulu_get_info(lulu_VM *L, const char *options, lulu_Debug *ar)
 {
-    lulu_assert(ar->_cf_index != 0);
-    Call_Frame *cf = small_array_get_ptr(&L->frames, ar->_cf_index);
+    lulu_assert(0 <= ar->_cf_index && ar->_cf_index < len(L->frames));
+    Call_Frame *cf = &L->frames[ar->_cf_index];
     get_info(L, options, ar, cf->function, cf);
     return 1;
 }
@@ -684,14 +723,15 @@ LULU_API int
 lulu_get_stack(lulu_VM *L, int level, lulu_Debug *ar)
 {
     const Call_Frame *cf      = L->caller;
-    const Call_Frame *base    = raw_data(L->frames.data);
+    const Call_Frame *base    = raw_data(L->frames);
     int               counter = level;
     for (; counter > 0 && cf > base; cf--) {
         counter--;
     }
 
-    // Level found?
-    if (counter == 0 && cf > base) {
+    // Level found? The first frame is only of interest when it is a Lua
+    // function, i.e. the main function of a coroutine.
+    if (counter == 0 && cf != nullptr && (cf > base || cf->is_lua())) {
         ar->_cf_index = static_cast<int>(cf - base);
         return 1;
     }
@@ -43,35 +43,41 @@ closure_delete(lulu_VM *L, Closure *f)
 Upvalue *
 upvalue_find(lulu_VM *L, Value *local)
 {
-    Object *olist = L->open_upvalues;
     // Try to find and reuse an existing upvalue that references 'local'.
-    while (olist != nullptr) {
-        Upvalue *up = &olist->upvalue;
-
-        // We assume the upvalue list is sorted (in terms of stack slots).
-        // If we find one who is below the target, we must have gone past the
-        // slot we want to close over meaning there is no upvalue for it.
-        if (up->value < local) {
-            break;
-        }
-
-        // Ensure this value is actually open.
-        lulu_assert(up->value != &up->closed);
+    int i = ptr_index(L->stack, local);
+    if (L->open_slots[i] != nullptr) {
+        lulu_assert(L->open_slots[i]->value == local);
+        return L->open_slots[i];
+    }
 
-        // Found the upvalue we are looking for?
-        if (up->value == local) {
-            // Reuse it.
-            return up;
+    // The list is sorted from the highest stack slot down, which is what
+    // `upvalue_close()` relies on. Locals are usually captured from the top
+    // of the stack, i.e. right at the head of the list. Otherwise we insert
+    // right after the nearest open upvalue above `local`.
+    Object_List *head = L->open_upvalues;
+    Upvalue     *prev = nullptr;
+    if (head != nullptr && head->upvalue.value > local) {
+        int above = i + 1;
+        while (L->open_slots[above] == nullptr) {
+            above++;
         }
-        olist = up->next;
+        prev = L->open_slots[above];
     }
 
     // Couldn't find an upvalue; need to make a new one.
     // New upvalue is always open. Add it to the VM's open upvalue list.
-    Upvalue *up = object_new<Upvalue>(L, &L->open_upvalues, VALUE_UPVALUE);
+    // `Object_Header` is packed, so we cannot take the address of `next`.
+    Object_List *list = (prev == nullptr) ? head : prev->next;
+    Upvalue     *up   = object_new<Upvalue>(L, &list, VALUE_UPVALUE);
+    if (prev == nullptr) {
+        L->open_upvalues = list;
+    } else {
+        prev->next = list;
+    }
 
     // Current value lives on the stack. Closed is not yet used.
-    up->value = local;
+    up->value        = local;
+    L->open_slots[i] = up;
     return up;
 }
 
@@ -99,6 +105,7 @@ upvalue_close(lulu_VM *L, Value *level)
         }
 
         L->open_upvalues = up->next;
+        L->open_slots[ptr_index(L->stack, up->value)] = nullptr;
         // TODO: check if object is dead
         // upvalue_unlink(up);
 
@@ -7,6 +7,9 @@ struct Closure_Header : Object_Header {
     u8 n_upvalues;
     bool is_c;
 
+    // C functions only. See `lulu_push_light_function()`.
+    bool is_light;
+
     // Only used during the mark and traverse phases of GC.
     // This object is always independent, so it can be a root.
     GC_List *gc_list;
@@ -6,6 +6,13 @@
 static int n_calls = 1;
 #endif // LULU_DEBUG_LOG_GC
 
+static lulu_VM *
+gc_to_thread(Object *o)
+{
+    lulu_assert(o->type() == VALUE_THREAD);
+    return reinterpret_cast<lulu_VM *>(o);
+}
+
 /**
  * @note(2025-08-27)
  *      Analogous to `memory.c:markObject()` in Crafting Interpreters 26.3:
@@ -48,6 +55,9 @@ gc_mark_object(lulu_Global *g, Object *o)
     case VALUE_CHUNK:
         o->chunk.gc_list = next;
         break;
+    case VALUE_THREAD:
+        gc_to_thread(o)->gc_list = next;
+        break;
     default:
         lulu_panicf("Object '%s' has no member 'gc_list'", o->type_name());
         break;
@@ -79,6 +89,9 @@ gc_mark_object(lulu_Global *g, Object *o)
         case VALUE_CHUNK:
             g->gray_tail->chunk.gc_list = o;
             break;
+        case VALUE_THREAD:
+            gc_to_thread(g->gray_tail)->gc_list = o;
+            break;
         default:
             lulu_panicf("Object '%s' has no member 'gc_list'",
                 g->gray_tail->type_name());
@@ -143,6 +156,12 @@ gc_blacken_chunk(lulu_Global *g, Chunk *p)
     }
 
     gc_mark_object(g, p->source->to_object());
+
+    // The cache must not keep its closure alive. If it was not reached yet
+    // it may never be, so we cannot assume it will still exist after sweep.
+    if (p->cache != nullptr && p->cache->is_white()) {
+        p->cache = nullptr;
+    }
     return &p->gc_list;
 }
 
@@ -232,11 +251,10 @@ gc_blacken_upvalue(lulu_Global *g, Upvalue *up)
         return;
     }
 
-    // Closed is only our child when we are, well, closed.
-    // When open the value lives on the stack we the GC took care of it.
-    if (up->value == &up->closed) {
-        gc_mark_value(g, up->closed);
-    }
+    // When open, the value normally lives on the stack of a thread the GC
+    // already took care of. But it may also be that of an unreachable
+    // coroutine, whose upvalues are closed when it is swept.
+    gc_mark_value(g, *up->value);
     up->set_black();
 }
 
@@ -271,6 +289,48 @@ gc_blacken_userdata(lulu_Global *g, Userdata *ud)
     return &ud->gc_list;
 }
 
+/** @brief Marks everything in use by thread `L`.
+ *
+ * @note(2025-09-18)
+ *      Analogous to `lgc.c:traversestack()` in Lua 5.1.5.
+ */
+static void
+gc_mark_thread(lulu_Global *g, lulu_VM *L)
+{
+    // Full/active stack.
+    Slice<Value> stack = slice_pointer(raw_data(L->stack), vm_ptr_top(L));
+    for (Value &v : stack) {
+        gc_mark_value(g, v);
+    }
+
+    // Calls do not clear all of their registers, so the rest of the stack
+    // must not refer to anything which may be collected.
+    fill(slice_from(L->stack, len(stack)), nil);
+
+    // Pointers to active function objects are also reachable.
+    for (Call_Frame &cf : slice(L->frames)) {
+        gc_mark_object(g, reinterpret_cast<Object *>(cf.function));
+    }
+
+    // All open upvalues are also reachable.
+    for (Object *o = L->open_upvalues; o != nullptr; o = o->next()) {
+        gc_blacken_upvalue(g, &o->upvalue);
+    }
+
+    // Globals table is always reachable, save it for later when tracing.
+    // We should not reach this point at VM startup.
+    gc_mark_value(g, L->globals);
+}
+
+static GC_List **
+gc_blacken_thread(lulu_Global *g, lulu_VM *L)
+{
+    lulu_assert(L->is_gray());
+    L->set_black();
+    gc_mark_thread(g, L);
+    return &L->gc_list;
+}
+
 static GC_List *
 gc_blacken_object(lulu_Global *g, Object *o)
 {
@@ -297,6 +357,9 @@ gc_blacken_object(lulu_Global *g, Object *o)
     case VALUE_USERDATA:
         next = gc_blacken_userdata(g, &o->userdata);
         break;
+    case VALUE_THREAD:
+        next = gc_blacken_thread(g, gc_to_thread(o));
+        break;
     default:
         lulu_panicf("Cannot blacken object type '%s'", o->type_name());
         break;
@@ -331,6 +394,38 @@ gc_trace_references(lulu_Global *g)
 }
 
 
+/** @brief Open upvalues are never swept themselves, so their marks must be
+ *  reset by their thread.
+ */
+static void
+gc_whiten_upvalues(lulu_VM *L)
+{
+    for (Object *o = L->open_upvalues; o != nullptr; o = o->next()) {
+        o->base.set_white();
+    }
+}
+
+/** @brief Closes the open upvalues of the unreachable coroutine `co`, linking
+ *  them in right before `next` so that they are swept next. Those still in
+ *  use by closures were marked along with their values.
+ *
+ * @return The new `next`.
+ */
+static Object *
+gc_close_upvalues(lulu_VM *co, Object *next)
+{
+    while (co->open_upvalues != nullptr) {
+        Upvalue *up       = &co->open_upvalues->upvalue;
+        co->open_upvalues = up->next;
+
+        up->closed = *up->value;
+        up->value  = &up->closed;
+        up->next   = next;
+        next       = up->to_object();
+    }
+    return next;
+}
+
 /**
  * @note(2025-08-27)
  *      Analogous to `memory.c:sweep()` in Crafting Interpreters
@@ -350,6 +445,9 @@ gc_sweep(lulu_VM *L, lulu_Global *g)
         if (o->base.is_black() || o->base.is_fixed()) {
             // Prepare for the next cycle.
             o->base.set_white();
+            if (o->type() == VALUE_THREAD) {
+                gc_whiten_upvalues(gc_to_thread(o));
+            }
 
             // We may unlink an unreachable object from this one.
             prev = o;
@@ -360,6 +458,9 @@ gc_sweep(lulu_VM *L, lulu_Global *g)
         // If the object is still gray, then that means we messed up somewhere
         // as we failed to traverse it.
         lulu_assert(!o->base.is_gray());
+        if (o->type() == VALUE_THREAD) {
+            next = gc_close_upvalues(gc_to_thread(o), next);
+        }
 
         // Unlink the unreached object from its parent linked list right
         // before we free it.
@@ -371,43 +472,29 @@ gc_sweep(lulu_VM *L, lulu_Global *g)
         o = next;
         object_free(L, unreached);
     }
+    gc_whiten_upvalues(g->main_thread);
 }
 
 static void
 gc_mark_roots(lulu_VM *L, lulu_Global *g)
 {
     g->gc_state = GC_MARK;
-    // Full/active stack.
-    Slice<Value> stack = slice_pointer(raw_data(L->stack), vm_ptr_top(L));
-    for (Value &v : stack) {
-        gc_mark_value(g, v);
-    }
-
-    // Pointers to active function objects are also reachable.
-    for (Call_Frame &cf : small_array_slice(L->frames)) {
-        gc_mark_object(g, reinterpret_cast<Object *>(cf.function));
-    }
+    gc_mark_thread(g, g->main_thread);
 
-    // All open upvalues are also reachable.
-    // @note(2025-08-30) Perhaps this is redunant? Upvalues in the open upvalue
-    // list are not reachable by the main objects list, so they cannot be
-    // freed anyway?
-    for (Object *o = L->open_upvalues; o != nullptr; o = o->next()) {
-        gc_blacken_upvalue(g, &o->upvalue);
+    // The running coroutine may not be reachable from anywhere else, e.g. if
+    // it was resumed by the C API then popped.
+    if (L != g->main_thread) {
+        gc_mark_object(g, L->to_object());
     }
 
     // All registered metatables for basic bytes are always reachable.
-    for (Table *t : slice_pointer_len(g->mt_basic, MT_COUNT)) {
+    for (Table *t : slice_pointer_len(g->mt_basic, count_of(g->mt_basic))) {
         if (t != nullptr) {
             gc_mark_object(g, t->to_object());
         }
     }
 
     gc_mark_value(g, g->registry);
-
-    // Globals table is always reachable, save it for later when tracing.
-    // We should not reach this point at VM startup.
-    gc_mark_value(g, L->globals);
 }
 
 void
@@ -0,0 +1,433 @@
+#include "jit.hpp"
+
+#if LULU_JIT
+
+#include <limits.h>   // INT_MAX
+#include <stddef.h>   // offsetof
+#include <string.h>   // memcpy
+#include <sys/mman.h> // mmap, mprotect, munmap
+
+#include "jit_stencils.hpp"
+#include "table.hpp"
+
+#if LULU_NAN_BOXING
+#   error "LULU_JIT requires the tagged `Value` layout (LULU_NAN_BOXING=0)"
+#endif // LULU_NAN_BOXING
+
+// The stencils hard-code these; see `tools/jit_stencils.py`.
+static_assert(VALUE_NIL == 0 && VALUE_BOOLEAN == 1 && VALUE_NUMBER == 3
+    && VALUE_TABLE == 5 && VALUE_INTEGER == 11,
+    "Please update `tools/jit_stencils.py` to match `Value_Type`");
+static_assert(sizeof(Value) == 16, "Stencils assume 16-byte `Value`");
+
+struct Jit_Compiler {
+    Chunk *chunk;
+
+    // Where the machine code is written to, or `nullptr` when we only want
+    // to find the offsets of everything.
+    u8 *code;
+
+    // Length of the machine code so far.
+    isize len;
+
+    // Offset into `code` of the native code of each pc.
+    Slice<u32> offsets;
+
+    // Offset into `code` of the exit of each pc, i.e. the code which returns
+    // that pc to the interpreter.
+    Slice<u32> exits;
+
+    // What to patch each kind of hole with. Holes for jumps hold offsets
+    // into `code`.
+    isize holes[JIT_HOLE_SKIP + 1];
+};
+
+static isize
+reg_offset(u16 reg)
+{
+    return static_cast<isize>(reg) * size_of(Value);
+}
+
+static void
+patch(Jit_Compiler *J, isize at, const Jit_Hole &hole)
+{
+    isize value = J->holes[hole.kind] + hole.addend;
+    switch (hole.kind) {
+    case JIT_HOLE_EXIT:
+    case JIT_HOLE_TARGET:
+    case JIT_HOLE_SKIP:
+        // Relative to the hole itself.
+        value -= at + hole.offset;
+        break;
+    default:
+        break;
+    }
+
+    u8 *dst = J->code + at + hole.offset;
+    if (hole.size == 8) {
+        u64 v = static_cast<u64>(value);
+        memcpy(dst, &v, sizeof(v));
+    } else {
+        lulu_assert(hole.size == 4);
+        i32 v = static_cast<i32>(value);
+        memcpy(dst, &v, sizeof(v));
+    }
+}
+
+/** @brief Copies the stencil `id` and patches its holes. */
+static void
+emit(Jit_Compiler *J, Jit_Stencil_Id id)
+{
+    const Jit_Stencil &s = jit_stencils[id];
+    if (J->code != nullptr) {
+        memcpy(J->code + J->len, s.code, static_cast<usize>(s.size));
+        for (isize i = 0; i < s.n_holes; i++) {
+            patch(J, J->len, s.holes[i]);
+        }
+    }
+    J->len += s.size;
+}
+
+static void
+set_jump(Jit_Compiler *J, Jit_Hole_Kind kind, isize pc)
+{
+    J->holes[kind] = static_cast<isize>(J->offsets[pc]);
+}
+
+/** @brief Points r8 (if `left`) or r9 (otherwise) to `RK(reg)`. */
+static void
+emit_load(Jit_Compiler *J, u16 reg, bool left)
+{
+    if (Instruction::reg_is_k(reg)) {
+        const Value *k = &J->chunk->constants[Instruction::reg_get_k(reg)];
+        J->holes[JIT_HOLE_OPERAND] = reinterpret_cast<isize>(k);
+        emit(J, left ? STENCIL_LOAD_LEFT_K : STENCIL_LOAD_RIGHT_K);
+    } else {
+        J->holes[JIT_HOLE_OPERAND] = reg_offset(reg);
+        emit(J, left ? STENCIL_LOAD_LEFT_REG : STENCIL_LOAD_RIGHT_REG);
+    }
+}
+
+static void
+emit_binary(Jit_Compiler *J, Instruction i, Jit_Stencil_Id id)
+{
+    emit_load(J, i.b(), /*left=*/true);
+    emit_load(J, i.c(), /*left=*/false);
+    emit(J, id);
+}
+
+/** @brief Returns control to the interpreter at `pc`. Always returns false. */
+static bool
+emit_exit(Jit_Compiler *J, isize pc)
+{
+    J->holes[JIT_HOLE_INDEX] = pc;
+    emit(J, STENCIL_EXIT);
+    return false;
+}
+
+static bool
+is_constant_non_number(Jit_Compiler *J, u16 reg)
+{
+    if (!Instruction::reg_is_k(reg)) {
+        return false;
+    }
+    return !J->chunk->constants[Instruction::reg_get_k(reg)].is_number();
+}
+
+/**
+ * @brief
+ *      Takes the `OP_JUMP` at `pc + 1` if the result in `al` is `cond`, else
+ *      skips over it.
+ */
+static void
+emit_branch(Jit_Compiler *J, isize pc, bool cond)
+{
+    Instruction jump = J->chunk->code[pc + 1];
+    lulu_assert(jump.op() == OP_JUMP);
+    set_jump(J, JIT_HOLE_TARGET, pc + 2 + jump.sbx());
+    set_jump(J, JIT_HOLE_SKIP, pc + 2);
+    emit(J, cond ? STENCIL_BRANCH_TRUE : STENCIL_BRANCH_FALSE);
+}
+
+/**
+ * @return
+ *      true if the instruction at `pc` has native code, else false, in which
+ *      case its code simply returns to the interpreter.
+ */
+static bool
+compile_instruction(Jit_Compiler *J, isize pc)
+{
+    Instruction i = J->chunk->code[pc];
+    J->holes[JIT_HOLE_RA] = reg_offset(i.a());
+    J->holes[JIT_HOLE_EXIT] = static_cast<isize>(J->exits[pc]);
+
+    switch (i.op()) {
+    case OP_MOVE:
+        emit_load(J, i.b(), /*left=*/true);
+        emit(J, STENCIL_MOVE);
+        break;
+    case OP_CONSTANT: {
+        const Value *k = &J->chunk->constants[i.bx()];
+        J->holes[JIT_HOLE_OPERAND] = reinterpret_cast<isize>(k);
+        emit(J, STENCIL_LOAD_LEFT_K);
+        emit(J, STENCIL_MOVE);
+        break;
+    }
+    case OP_NIL:
+        for (u16 reg = i.a(); reg <= i.b(); reg++) {
+            J->holes[JIT_HOLE_RA] = reg_offset(reg);
+            emit(J, STENCIL_NIL);
+        }
+        break;
+    case OP_BOOL:
+        J->holes[JIT_HOLE_INDEX] = static_cast<isize>(i.b() != 0);
+        emit(J, STENCIL_BOOL);
+        if (i.c() != 0) {
+            set_jump(J, JIT_HOLE_TARGET, pc + 2);
+            emit(J, STENCIL_JUMP);
+        }
+        break;
+    case OP_GET_UPVALUE:
+        J->holes[JIT_HOLE_INDEX] = i.b() * size_of(Upvalue *);
+        emit(J, STENCIL_LOAD_LEFT_UPVALUE);
+        emit(J, STENCIL_MOVE);
+        break;
+    case OP_SET_UPVALUE:
+        J->holes[JIT_HOLE_INDEX] = i.b() * size_of(Upvalue *);
+        emit(J, STENCIL_SET_UPVALUE);
+        break;
+
+    // Quickened or not, the native code is the same. Only the type guards
+    // differ, and those are always checked.
+    case OP_ADD:
+    case OP_ADD_NUM: emit_binary(J, i, STENCIL_ADD); break;
+    case OP_SUB:
+    case OP_SUB_NUM: emit_binary(J, i, STENCIL_SUB); break;
+    case OP_MUL:
+    case OP_MUL_NUM: emit_binary(J, i, STENCIL_MUL); break;
+    case OP_DIV:
+    case OP_DIV_NUM: emit_binary(J, i, STENCIL_DIV); break;
+    case OP_MOD:
+    case OP_MOD_NUM: emit_binary(J, i, STENCIL_MOD); break;
+    case OP_UNM:
+        emit_load(J, i.b(), /*left=*/true);
+        emit(J, STENCIL_UNM);
+        break;
+    case OP_NOT:
+        emit_load(J, i.b(), /*left=*/true);
+        emit(J, STENCIL_NOT);
+        break;
+    case OP_EQ:
+        emit_binary(J, i, STENCIL_EQ);
+        emit_branch(J, pc, i.a() != 0);
+        break;
+    case OP_LT:
+    case OP_LT_NUM:
+        emit_binary(J, i, STENCIL_LT);
+        emit_branch(J, pc, i.a() != 0);
+        break;
+    case OP_LEQ:
+    case OP_LEQ_NUM:
+        emit_binary(J, i, STENCIL_LEQ);
+        emit_branch(J, pc, i.a() != 0);
+        break;
+    case OP_TEST:
+        emit_load(J, i.a(), /*left=*/true);
+        emit(J, STENCIL_TRUTHY);
+        emit_branch(J, pc, i.c() != 0);
+        break;
+    case OP_TEST_SET: {
+        Instruction jump = J->chunk->code[pc + 1];
+        lulu_assert(jump.op() == OP_JUMP);
+        emit_load(J, i.b(), /*left=*/true);
+        emit(J, STENCIL_TRUTHY);
+        set_jump(J, JIT_HOLE_SKIP, pc + 2);
+        emit(J, (i.c() != 0) ? STENCIL_SKIP_FALSE : STENCIL_SKIP_TRUE);
+        emit(J, STENCIL_MOVE);
+        set_jump(J, JIT_HOLE_TARGET, pc + 2 + jump.sbx());
+        emit(J, STENCIL_JUMP);
+        break;
+    }
+    case OP_JUMP:
+        set_jump(J, JIT_HOLE_TARGET, pc + 1 + i.sbx());
+        emit(J, STENCIL_JUMP);
+        break;
+    case OP_JUMP_IF:
+    case OP_JUMP_IF_NOT:
+        emit_load(J, i.a(), /*left=*/true);
+        emit(J, STENCIL_TRUTHY);
+        set_jump(J, JIT_HOLE_TARGET, pc + 1 + i.sbx());
+        set_jump(J, JIT_HOLE_SKIP, pc + 1);
+        emit(J, (i.op() == OP_JUMP_IF) ? STENCIL_BRANCH_TRUE
+                                       : STENCIL_BRANCH_FALSE);
+        break;
+    case OP_FOR_LOOP:
+        emit_load(J, i.a(), /*left=*/true);
+        set_jump(J, JIT_HOLE_TARGET, pc + 1 + i.sbx());
+        emit(J, STENCIL_FOR_LOOP);
+        break;
+    // The chunk may be compiled before these were ever run, so the generic
+    // versions are assumed to have integer keys too unless we know better.
+    case OP_GET_TABLE:
+        if (is_constant_non_number(J, i.c())) {
+            return emit_exit(J, pc);
+        }
+        [[fallthrough]];
+    case OP_GET_TABLE_INT:
+        emit_load(J, i.c(), /*left=*/true);
+        emit_load(J, i.b(), /*left=*/false);
+        emit(J, STENCIL_GET_TABLE_INT);
+        break;
+    case OP_SET_TABLE:
+        if (is_constant_non_number(J, i.b())) {
+            return emit_exit(J, pc);
+        }
+        [[fallthrough]];
+    case OP_SET_TABLE_INT:
+        emit_load(J, i.b(), /*left=*/true);
+        emit_load(J, i.c(), /*left=*/false);
+        emit(J, STENCIL_SET_TABLE_INT);
+        break;
+    default:
+        return emit_exit(J, pc);
+    }
+    return true;
+}
+
+/**
+ * @param [out] entries
+ *      Receives `Jit_Code::entries`. Not written to if `J->code` is null.
+ */
+static void
+compile_chunk(Jit_Compiler *J, Slice<u32> entries)
+{
+    Slice<Instruction> code = J->chunk->code;
+    isize              n    = len(code);
+
+    J->len = 0;
+    emit(J, STENCIL_ENTRY);
+    for (isize pc = 0; pc < n; pc++) {
+        J->offsets[pc] = static_cast<u32>(J->len);
+        bool native    = compile_instruction(J, pc);
+        if (J->code != nullptr) {
+            entries[pc] = native ? J->offsets[pc] : 0;
+        }
+        if (!native) {
+            J->exits[pc] = J->offsets[pc];
+        }
+
+        // The instructions after `OP_CLOSURE` only describe its upvalues.
+        if (code[pc].op() == OP_CLOSURE) {
+            Chunk *child = J->chunk->children[code[pc].bx()];
+            for (int up = 0; up < child->n_upvalues; up++) {
+                pc++;
+                J->offsets[pc] = static_cast<u32>(J->len);
+                J->exits[pc]   = J->offsets[pc];
+                if (J->code != nullptr) {
+                    entries[pc] = 0;
+                }
+                emit_exit(J, pc);
+            }
+        }
+    }
+
+    // Instructions with native code leave through here when their operands
+    // do not have the expected types.
+    for (isize pc = 0; pc < n; pc++) {
+        if (J->exits[pc] == J->offsets[pc]) {
+            continue;
+        }
+        J->exits[pc] = static_cast<u32>(J->len);
+        emit_exit(J, pc);
+    }
+}
+
+// `Upvalue` and `Table` are not standard-layout, but their layouts are
+// still fixed so `offsetof()` gives the correct result.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+
+static void
+set_offsets(Jit_Compiler *J)
+{
+    isize array = static_cast<isize>(offsetof(Table, array));
+    J->holes[JIT_HOLE_UPVALUE_VALUE] = offsetof(Upvalue, value);
+    J->holes[JIT_HOLE_TABLE_METATABLE] = offsetof(Table, metatable);
+    J->holes[JIT_HOLE_TABLE_ARRAY]  = array + offsetof(Slice<Value>, data);
+    J->holes[JIT_HOLE_TABLE_LENGTH] = array + offsetof(Slice<Value>, len);
+}
+
+#pragma GCC diagnostic pop
+
+bool
+jit_compile(lulu_VM *L, Chunk *p)
+{
+    isize        n = len(p->code);
+    Jit_Compiler J{};
+    J.chunk = p;
+    set_offsets(&J);
+
+    // Both passes need the offsets of pcs which come after the current one.
+    // The first pass finds them, then the second uses them.
+    Slice<u32> buffer = slice_make<u32>(L, n * 2);
+    J.offsets = slice(buffer, 0, n);
+    J.exits   = slice(buffer, n, n * 2);
+    fill(buffer, 0u);
+    compile_chunk(&J, {});
+
+    usize entries_size = sizeof(u32) * static_cast<usize>(n);
+    usize code_offset  = (sizeof(Jit_Code) + entries_size + 15) & ~usize(15);
+    usize size         = code_offset + static_cast<usize>(J.len);
+
+    void *m = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (m == MAP_FAILED) {
+        slice_delete(L, buffer);
+        p->jit_hotness = INT_MAX;
+        return false;
+    }
+
+    Jit_Code *jit     = static_cast<Jit_Code *>(m);
+    jit->size         = size;
+    jit->entries      = {reinterpret_cast<u32 *>(jit + 1), n};
+    jit->machine_code = static_cast<u8 *>(m) + code_offset;
+    J.code            = jit->machine_code;
+    compile_chunk(&J, jit->entries);
+    lulu_assert(code_offset + static_cast<usize>(J.len) == size);
+    slice_delete(L, buffer);
+
+    if (mprotect(m, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(m, size);
+        p->jit_hotness = INT_MAX;
+        return false;
+    }
+    p->jit = jit;
+    return true;
+}
+
+void
+jit_free(Chunk *p)
+{
+    if (p->jit != nullptr) {
+        munmap(p->jit, p->jit->size);
+        p->jit = nullptr;
+    }
+}
+
+const Instruction *
+jit_run(const Closure_Lua *f, Value *base, const Instruction *ip)
+{
+    const Chunk       *p     = f->chunk;
+    const Jit_Code    *jit   = p->jit;
+    const Instruction *code  = raw_data(p->code);
+    u32                start = jit->entries[ip - code];
+    if (start == 0) {
+        return ip;
+    }
+
+    Jit_Function fn;
+    memcpy(&fn, &jit->machine_code, sizeof(fn));
+    return code + fn(base, jit->machine_code + start, f->upvalues);
+}
+
+#endif // LULU_JIT
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "chunk.hpp"
+#include "function.hpp"
+#include "vm.hpp"
+
+#if LULU_JIT
+
+/**
+ * @brief
+ *      Native code for one chunk, generated by `jit_compile()` by copying
+ *      and patching the machine code templates in `jit_stencils.hpp`.
+ *
+ * @details
+ *      Only simple instructions which can never throw nor call anything,
+ *      e.g. moves, arithmetic on numbers, comparisons and jumps, have native
+ *      code. Every other instruction, and any of the former whose operands
+ *      are not of the expected types, instead returns to the interpreter to
+ *      run it. Hence exceptions never need to unwind through native frames.
+ *
+ *      This header, `entries` and `machine_code` all live in the same
+ *      mapping, which is read-only and executable once filled in.
+ */
+struct Jit_Code {
+    // Size of the entire mapping, including this header.
+    usize size;
+
+    // Offset into `machine_code` of the instruction at each pc, or 0 if the
+    // interpreter cannot continue there. `len(entries) == len(Chunk::code)`.
+    Slice<u32> entries;
+
+    // Starts with `STENCIL_ENTRY`, which is why no entry is ever 0.
+    u8 *machine_code;
+};
+
+/**
+ * @param base
+ *      Base of the register window, i.e. `&R(0)`.
+ *
+ * @param start
+ *      Native code of the instruction to start at, from `Jit_Code::entries`.
+ *
+ * @return
+ *      The pc of the instruction the interpreter must run next.
+ */
+using Jit_Function = u32 (*)(Value *base, const u8 *start,
+    Upvalue *const *upvalues);
+
+/**
+ * @brief
+ *      Compiles `p` to native code. Compilation is attempted only once.
+ *
+ * @return
+ *      true if `p->jit` is now usable, else false.
+ */
+bool
+jit_compile(lulu_VM *L, Chunk *p);
+
+void
+jit_free(Chunk *p);
+
+/** @brief Runs the native code of `f`, which must exist, from `ip`. */
+const Instruction *
+jit_run(const Closure_Lua *f, Value *base, const Instruction *ip);
+
+/**
+ * @brief
+ *      Called by `vm_execute()` on function entry and return, and at the
+ *      end of every loop iteration. Counts towards compiling the chunk
+ *      being run, and runs its native code from `ip` if it has any.
+ *
+ * @return
+ *      Where the interpreter must continue from. This is `ip` itself if
+ *      `ip` has no native code.
+ */
+inline const Instruction *
+jit_enter(lulu_VM *L, const Closure_Lua *f, Value *base,
+    const Instruction *ip)
+{
+    if (!G(L)->jit_enabled) {
+        return ip;
+    }
+
+    Chunk *p = f->chunk;
+    if (p->jit == nullptr) {
+        if (--p->jit_hotness > 0) {
+            return ip;
+        }
+        // Compilation may throw a memory error.
+        L->saved_ip = ip;
+        if (!jit_compile(L, p)) {
+            return ip;
+        }
+    }
+    return jit_run(f, base, ip);
+}
+
+#endif // LULU_JIT
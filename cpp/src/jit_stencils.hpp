@@ -0,0 +1,543 @@
+// Generated by `tools/jit_stencils.py`. Do not edit by hand!
+#pragma once
+
+#include "private.hpp"
+
+enum Jit_Hole_Kind : u8 {
+    JIT_HOLE_RA,
+    JIT_HOLE_OPERAND,
+    JIT_HOLE_INDEX,
+    JIT_HOLE_UPVALUE_VALUE,
+    JIT_HOLE_TABLE_ARRAY,
+    JIT_HOLE_TABLE_LENGTH,
+    JIT_HOLE_TABLE_METATABLE,
+    JIT_HOLE_EXIT,
+    JIT_HOLE_TARGET,
+    JIT_HOLE_SKIP,
+};
+
+struct Jit_Hole {
+    u16           offset;
+    Jit_Hole_Kind kind;
+    u8            size; // In bytes.
+    i32           addend;
+};
+
+struct Jit_Stencil {
+    const u8       *code;
+    isize           size;
+    const Jit_Hole *holes;
+    isize           n_holes;
+};
+
+enum Jit_Stencil_Id : u8 {
+    STENCIL_ENTRY,
+    STENCIL_EXIT,
+    STENCIL_LOAD_LEFT_REG,
+    STENCIL_LOAD_LEFT_K,
+    STENCIL_LOAD_RIGHT_REG,
+    STENCIL_LOAD_RIGHT_K,
+    STENCIL_LOAD_LEFT_UPVALUE,
+    STENCIL_MOVE,
+    STENCIL_SET_UPVALUE,
+    STENCIL_NIL,
+    STENCIL_BOOL,
+    STENCIL_JUMP,
+    STENCIL_ADD,
+    STENCIL_SUB,
+    STENCIL_MUL,
+    STENCIL_DIV,
+    STENCIL_MOD,
+    STENCIL_UNM,
+    STENCIL_NOT,
+    STENCIL_TRUTHY,
+    STENCIL_EQ,
+    STENCIL_LT,
+    STENCIL_LEQ,
+    STENCIL_BRANCH_TRUE,
+    STENCIL_BRANCH_FALSE,
+    STENCIL_SKIP_TRUE,
+    STENCIL_SKIP_FALSE,
+    STENCIL_FOR_LOOP,
+    STENCIL_GET_TABLE_INT,
+    STENCIL_SET_TABLE_INT,
+};
+
+static const u8 stencil_entry_code[] = {
+    0xff, 0xe6,
+};
+
+static const u8 stencil_exit_code[] = {
+    0xb8, 0x00, 0x00, 0x00, 0x00, 0xc3,
+};
+
+static const Jit_Hole stencil_exit_holes[] = {
+    {1, JIT_HOLE_INDEX, 4, 0},
+};
+
+static const u8 stencil_load_left_reg_code[] = {
+    0x4c, 0x8d, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_load_left_reg_holes[] = {
+    {3, JIT_HOLE_OPERAND, 4, 0},
+};
+
+static const u8 stencil_load_left_k_code[] = {
+    0x49, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_load_left_k_holes[] = {
+    {2, JIT_HOLE_OPERAND, 8, 0},
+};
+
+static const u8 stencil_load_right_reg_code[] = {
+    0x4c, 0x8d, 0x8f, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_load_right_reg_holes[] = {
+    {3, JIT_HOLE_OPERAND, 4, 0},
+};
+
+static const u8 stencil_load_right_k_code[] = {
+    0x49, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_load_right_k_holes[] = {
+    {2, JIT_HOLE_OPERAND, 8, 0},
+};
+
+static const u8 stencil_load_left_upvalue_code[] = {
+    0x4c, 0x8b, 0x82, 0x00, 0x00, 0x00, 0x00, 0x4d, 0x8b, 0x80, 0x00, 0x00,
+    0x00, 0x00,
+};
+
+static const Jit_Hole stencil_load_left_upvalue_holes[] = {
+    {3, JIT_HOLE_INDEX, 4, 0},
+    {10, JIT_HOLE_UPVALUE_VALUE, 4, 0},
+};
+
+static const u8 stencil_move_code[] = {
+    0x41, 0x0f, 0x10, 0x00, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_move_holes[] = {
+    {7, JIT_HOLE_RA, 4, 0},
+};
+
+static const u8 stencil_set_upvalue_code[] = {
+    0x48, 0x8b, 0x82, 0x00, 0x00, 0x00, 0x00, 0x48, 0x8b, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x0f, 0x10, 0x87, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x11, 0x00,
+};
+
+static const Jit_Hole stencil_set_upvalue_holes[] = {
+    {3, JIT_HOLE_INDEX, 4, 0},
+    {10, JIT_HOLE_UPVALUE_VALUE, 4, 0},
+    {17, JIT_HOLE_RA, 4, 0},
+};
+
+static const u8 stencil_nil_code[] = {
+    0x0f, 0x57, 0xc0, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_nil_holes[] = {
+    {6, JIT_HOLE_RA, 4, 0},
+};
+
+static const u8 stencil_bool_code[] = {
+    0x48, 0xc7, 0x87, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc6,
+    0x87, 0x00, 0x00, 0x00, 0x00, 0x01,
+};
+
+static const Jit_Hole stencil_bool_holes[] = {
+    {3, JIT_HOLE_RA, 4, 8},
+    {7, JIT_HOLE_INDEX, 4, 0},
+    {13, JIT_HOLE_RA, 4, 0},
+};
+
+static const u8 stencil_jump_code[] = {
+    0xe9, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_jump_holes[] = {
+    {1, JIT_HOLE_TARGET, 4, -4},
+};
+
+static const u8 stencil_add_code[] = {
+    0x41, 0x80, 0x38, 0x0b, 0x75, 0x3a, 0x41, 0x80, 0x39, 0x0b, 0x75, 0x34,
+    0x49, 0x8b, 0x40, 0x08, 0x49, 0x03, 0x41, 0x08, 0x48, 0xb9, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x48, 0x01, 0xc1, 0x49, 0xba, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x4c, 0x39, 0xd1, 0x77, 0x10,
+    0xc6, 0x87, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x48, 0x89, 0x87, 0x00, 0x00,
+    0x00, 0x00, 0xeb, 0x4f, 0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41,
+    0x0f, 0x10, 0x40, 0x08, 0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85,
+    0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x41, 0x80,
+    0x39, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0xeb, 0x10,
+    0x41, 0x80, 0x39, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49,
+    0x0f, 0x2a, 0x49, 0x08, 0xf2, 0x0f, 0x58, 0xc1, 0xc6, 0x87, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0xf2, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_add_holes[] = {
+    {50, JIT_HOLE_RA, 4, 0},
+    {58, JIT_HOLE_RA, 4, 8},
+    {84, JIT_HOLE_EXIT, 4, -4},
+    {114, JIT_HOLE_EXIT, 4, -4},
+    {130, JIT_HOLE_RA, 4, 0},
+    {139, JIT_HOLE_RA, 4, 8},
+};
+
+static const u8 stencil_sub_code[] = {
+    0x41, 0x80, 0x38, 0x0b, 0x75, 0x3a, 0x41, 0x80, 0x39, 0x0b, 0x75, 0x34,
+    0x49, 0x8b, 0x40, 0x08, 0x49, 0x2b, 0x41, 0x08, 0x48, 0xb9, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x48, 0x01, 0xc1, 0x49, 0xba, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x4c, 0x39, 0xd1, 0x77, 0x10,
+    0xc6, 0x87, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x48, 0x89, 0x87, 0x00, 0x00,
+    0x00, 0x00, 0xeb, 0x4f, 0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41,
+    0x0f, 0x10, 0x40, 0x08, 0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85,
+    0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x41, 0x80,
+    0x39, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0xeb, 0x10,
+    0x41, 0x80, 0x39, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49,
+    0x0f, 0x2a, 0x49, 0x08, 0xf2, 0x0f, 0x5c, 0xc1, 0xc6, 0x87, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0xf2, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_sub_holes[] = {
+    {50, JIT_HOLE_RA, 4, 0},
+    {58, JIT_HOLE_RA, 4, 8},
+    {84, JIT_HOLE_EXIT, 4, -4},
+    {114, JIT_HOLE_EXIT, 4, -4},
+    {130, JIT_HOLE_RA, 4, 0},
+    {139, JIT_HOLE_RA, 4, 8},
+};
+
+static const u8 stencil_mul_code[] = {
+    0x41, 0x80, 0x38, 0x0b, 0x75, 0x52, 0x41, 0x80, 0x39, 0x0b, 0x75, 0x4c,
+    0x49, 0x8b, 0x40, 0x08, 0x49, 0x8b, 0x49, 0x08, 0x4c, 0x8d, 0x90, 0x00,
+    0x00, 0x00, 0x04, 0x49, 0x81, 0xfa, 0x00, 0x00, 0x00, 0x08, 0x77, 0x34,
+    0x4c, 0x8d, 0x91, 0x00, 0x00, 0x00, 0x04, 0x49, 0x81, 0xfa, 0x00, 0x00,
+    0x00, 0x08, 0x77, 0x24, 0x49, 0x89, 0xc2, 0x49, 0x09, 0xca, 0x48, 0x0f,
+    0xaf, 0xc1, 0x48, 0x85, 0xc0, 0x75, 0x05, 0x4d, 0x85, 0xd2, 0x78, 0x10,
+    0xc6, 0x87, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x48, 0x89, 0x87, 0x00, 0x00,
+    0x00, 0x00, 0xeb, 0x4f, 0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41,
+    0x0f, 0x10, 0x40, 0x08, 0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85,
+    0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x41, 0x80,
+    0x39, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0xeb, 0x10,
+    0x41, 0x80, 0x39, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49,
+    0x0f, 0x2a, 0x49, 0x08, 0xf2, 0x0f, 0x59, 0xc1, 0xc6, 0x87, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0xf2, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_mul_holes[] = {
+    {74, JIT_HOLE_RA, 4, 0},
+    {82, JIT_HOLE_RA, 4, 8},
+    {108, JIT_HOLE_EXIT, 4, -4},
+    {138, JIT_HOLE_EXIT, 4, -4},
+    {154, JIT_HOLE_RA, 4, 0},
+    {163, JIT_HOLE_RA, 4, 8},
+};
+
+static const u8 stencil_div_code[] = {
+    0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x40, 0x08,
+    0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x41, 0x80, 0x39, 0x03, 0x75, 0x08,
+    0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0xeb, 0x10, 0x41, 0x80, 0x39, 0x0b,
+    0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x49, 0x08,
+    0xf2, 0x0f, 0x5e, 0xc1, 0xc6, 0x87, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf2,
+    0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_div_holes[] = {
+    {20, JIT_HOLE_EXIT, 4, -4},
+    {50, JIT_HOLE_EXIT, 4, -4},
+    {66, JIT_HOLE_RA, 4, 0},
+    {75, JIT_HOLE_RA, 4, 8},
+};
+
+static const u8 stencil_mod_code[] = {
+    0x49, 0x8b, 0x49, 0x08, 0x41, 0x80, 0x39, 0x0b, 0x74, 0x41, 0x41, 0x80,
+    0x39, 0x03, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10,
+    0x59, 0x08, 0xf2, 0x48, 0x0f, 0x2c, 0xcb, 0x48, 0xb8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x20, 0x00, 0x48, 0x01, 0xc8, 0x48, 0xc1, 0xe8, 0x36,
+    0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x48, 0x0f, 0x2a, 0xd1, 0x66,
+    0x0f, 0x2e, 0xd3, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x8a, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0x85, 0xc9, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00,
+    0x4d, 0x8b, 0x50, 0x08, 0x41, 0x80, 0x38, 0x0b, 0x74, 0x41, 0x41, 0x80,
+    0x38, 0x03, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x41, 0x0f, 0x10,
+    0x58, 0x08, 0xf2, 0x4c, 0x0f, 0x2c, 0xd3, 0x48, 0xb8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x20, 0x00, 0x4c, 0x01, 0xd0, 0x48, 0xc1, 0xe8, 0x36,
+    0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0xd2, 0x66,
+    0x0f, 0x2e, 0xd3, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x8a, 0x00,
+    0x00, 0x00, 0x00, 0x49, 0x89, 0xd3, 0x4c, 0x89, 0xd0, 0x48, 0x99, 0x48,
+    0xf7, 0xf9, 0x48, 0x89, 0xd0, 0x4c, 0x89, 0xda, 0x48, 0x85, 0xc0, 0x75,
+    0x0b, 0x49, 0x83, 0x78, 0x08, 0x00, 0x0f, 0x8c, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x48, 0x0f, 0x2a, 0xc0, 0xc6, 0x87, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0xf2, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_mod_holes[] = {
+    {16, JIT_HOLE_EXIT, 4, -4},
+    {50, JIT_HOLE_EXIT, 4, -4},
+    {65, JIT_HOLE_EXIT, 4, -4},
+    {71, JIT_HOLE_EXIT, 4, -4},
+    {80, JIT_HOLE_EXIT, 4, -4},
+    {100, JIT_HOLE_EXIT, 4, -4},
+    {134, JIT_HOLE_EXIT, 4, -4},
+    {149, JIT_HOLE_EXIT, 4, -4},
+    {155, JIT_HOLE_EXIT, 4, -4},
+    {188, JIT_HOLE_EXIT, 4, -4},
+    {199, JIT_HOLE_RA, 4, 0},
+    {208, JIT_HOLE_RA, 4, 8},
+};
+
+static const u8 stencil_unm_code[] = {
+    0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x40, 0x08,
+    0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x48, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0x66, 0x48, 0x0f, 0x6e, 0xc8, 0x66, 0x0f, 0x57,
+    0xc1, 0xc6, 0x87, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf2, 0x0f, 0x11, 0x87,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_unm_holes[] = {
+    {20, JIT_HOLE_EXIT, 4, -4},
+    {51, JIT_HOLE_RA, 4, 0},
+    {60, JIT_HOLE_RA, 4, 8},
+};
+
+static const u8 stencil_not_code[] = {
+    0x41, 0x0f, 0xb6, 0x00, 0x83, 0xf8, 0x01, 0x77, 0x0e, 0x72, 0x13, 0x41,
+    0x0f, 0xb6, 0x40, 0x08, 0x85, 0xc0, 0x0f, 0x95, 0xc0, 0xeb, 0x09, 0xb8,
+    0x01, 0x00, 0x00, 0x00, 0xeb, 0x02, 0x31, 0xc0, 0x83, 0xf0, 0x01, 0x48,
+    0x89, 0x87, 0x00, 0x00, 0x00, 0x00, 0xc6, 0x87, 0x00, 0x00, 0x00, 0x00,
+    0x01,
+};
+
+static const Jit_Hole stencil_not_holes[] = {
+    {38, JIT_HOLE_RA, 4, 8},
+    {44, JIT_HOLE_RA, 4, 0},
+};
+
+static const u8 stencil_truthy_code[] = {
+    0x41, 0x0f, 0xb6, 0x00, 0x83, 0xf8, 0x01, 0x77, 0x0e, 0x72, 0x13, 0x41,
+    0x0f, 0xb6, 0x40, 0x08, 0x85, 0xc0, 0x0f, 0x95, 0xc0, 0xeb, 0x09, 0xb8,
+    0x01, 0x00, 0x00, 0x00, 0xeb, 0x02, 0x31, 0xc0,
+};
+
+static const u8 stencil_eq_code[] = {
+    0x41, 0x0f, 0xb6, 0x00, 0x41, 0x0f, 0xb6, 0x09, 0x39, 0xc8, 0x75, 0x2d,
+    0x83, 0xf8, 0x03, 0x74, 0x58, 0x83, 0xf8, 0x01, 0x77, 0x09, 0x74, 0x14,
+    0xb8, 0x01, 0x00, 0x00, 0x00, 0xeb, 0x66, 0x49, 0x8b, 0x40, 0x08, 0x49,
+    0x3b, 0x41, 0x08, 0x0f, 0x94, 0xc0, 0xeb, 0x59, 0x41, 0x8a, 0x40, 0x08,
+    0x41, 0x3a, 0x41, 0x08, 0x0f, 0x94, 0xc0, 0xeb, 0x4c, 0x83, 0xf8, 0x03,
+    0x74, 0x18, 0x83, 0xf8, 0x0b, 0x75, 0x40, 0x83, 0xf9, 0x03, 0x75, 0x3b,
+    0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08,
+    0xeb, 0x1f, 0x83, 0xf9, 0x0b, 0x75, 0x28, 0xf2, 0x41, 0x0f, 0x10, 0x40,
+    0x08, 0xf2, 0x49, 0x0f, 0x2a, 0x49, 0x08, 0xeb, 0x0c, 0xf2, 0x41, 0x0f,
+    0x10, 0x40, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0x66, 0x0f, 0x2e,
+    0xc1, 0x0f, 0x94, 0xc0, 0x0f, 0x9b, 0xc1, 0x20, 0xc8, 0xeb, 0x02, 0x31,
+    0xc0,
+};
+
+static const u8 stencil_lt_code[] = {
+    0x41, 0x80, 0x38, 0x0b, 0x75, 0x13, 0x41, 0x80, 0x39, 0x0b, 0x75, 0x0d,
+    0x49, 0x8b, 0x40, 0x08, 0x49, 0x3b, 0x41, 0x08, 0x0f, 0x9c, 0xc0, 0xeb,
+    0x43, 0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x40,
+    0x08, 0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00,
+    0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x41, 0x80, 0x39, 0x03, 0x75,
+    0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0xeb, 0x10, 0x41, 0x80, 0x39,
+    0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x49,
+    0x08, 0x66, 0x0f, 0x2e, 0xc8, 0x0f, 0x97, 0xc0,
+};
+
+static const Jit_Hole stencil_lt_holes[] = {
+    {45, JIT_HOLE_EXIT, 4, -4},
+    {75, JIT_HOLE_EXIT, 4, -4},
+};
+
+static const u8 stencil_leq_code[] = {
+    0x41, 0x80, 0x38, 0x0b, 0x75, 0x13, 0x41, 0x80, 0x39, 0x0b, 0x75, 0x0d,
+    0x49, 0x8b, 0x40, 0x08, 0x49, 0x3b, 0x41, 0x08, 0x0f, 0x9e, 0xc0, 0xeb,
+    0x43, 0x41, 0x80, 0x38, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x40,
+    0x08, 0xeb, 0x10, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00,
+    0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x40, 0x08, 0x41, 0x80, 0x39, 0x03, 0x75,
+    0x08, 0xf2, 0x41, 0x0f, 0x10, 0x49, 0x08, 0xeb, 0x10, 0x41, 0x80, 0x39,
+    0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x49,
+    0x08, 0x66, 0x0f, 0x2e, 0xc8, 0x0f, 0x93, 0xc0,
+};
+
+static const Jit_Hole stencil_leq_holes[] = {
+    {45, JIT_HOLE_EXIT, 4, -4},
+    {75, JIT_HOLE_EXIT, 4, -4},
+};
+
+static const u8 stencil_branch_true_code[] = {
+    0x84, 0xc0, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00,
+    0x00,
+};
+
+static const Jit_Hole stencil_branch_true_holes[] = {
+    {4, JIT_HOLE_TARGET, 4, -4},
+    {9, JIT_HOLE_SKIP, 4, -4},
+};
+
+static const u8 stencil_branch_false_code[] = {
+    0x84, 0xc0, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00,
+    0x00,
+};
+
+static const Jit_Hole stencil_branch_false_holes[] = {
+    {4, JIT_HOLE_TARGET, 4, -4},
+    {9, JIT_HOLE_SKIP, 4, -4},
+};
+
+static const u8 stencil_skip_true_code[] = {
+    0x84, 0xc0, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_skip_true_holes[] = {
+    {4, JIT_HOLE_SKIP, 4, -4},
+};
+
+static const u8 stencil_skip_false_code[] = {
+    0x84, 0xc0, 0x0f, 0x84, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_skip_false_holes[] = {
+    {4, JIT_HOLE_SKIP, 4, -4},
+};
+
+static const u8 stencil_for_loop_code[] = {
+    0x41, 0x80, 0x38, 0x0b, 0x75, 0x38, 0x49, 0x8b, 0x40, 0x08, 0x49, 0x8b,
+    0x48, 0x28, 0x48, 0x01, 0xc8, 0x48, 0x85, 0xc9, 0x7e, 0x0c, 0x49, 0x3b,
+    0x40, 0x18, 0x0f, 0x8f, 0x98, 0x00, 0x00, 0x00, 0xeb, 0x0a, 0x49, 0x3b,
+    0x40, 0x18, 0x0f, 0x8c, 0x8c, 0x00, 0x00, 0x00, 0x49, 0x89, 0x40, 0x08,
+    0x41, 0xc6, 0x40, 0x30, 0x0b, 0x49, 0x89, 0x40, 0x38, 0xe9, 0x00, 0x00,
+    0x00, 0x00, 0x41, 0x80, 0x78, 0x20, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f,
+    0x10, 0x50, 0x28, 0xeb, 0x11, 0x41, 0x80, 0x78, 0x20, 0x0b, 0x0f, 0x85,
+    0x00, 0x00, 0x00, 0x00, 0xf2, 0x49, 0x0f, 0x2a, 0x50, 0x28, 0x41, 0x80,
+    0x78, 0x10, 0x03, 0x75, 0x08, 0xf2, 0x41, 0x0f, 0x10, 0x58, 0x18, 0xeb,
+    0x11, 0x41, 0x80, 0x78, 0x10, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00,
+    0xf2, 0x49, 0x0f, 0x2a, 0x58, 0x18, 0xf2, 0x41, 0x0f, 0x10, 0x40, 0x08,
+    0xf2, 0x0f, 0x58, 0xc2, 0x66, 0x0f, 0x57, 0xc9, 0x66, 0x0f, 0x2e, 0xd1,
+    0x77, 0x08, 0x66, 0x0f, 0x2e, 0xc3, 0x73, 0x0a, 0xeb, 0x1e, 0x66, 0x0f,
+    0x2e, 0xd8, 0x73, 0x02, 0xeb, 0x16, 0xf2, 0x41, 0x0f, 0x11, 0x40, 0x08,
+    0x41, 0xc6, 0x40, 0x30, 0x03, 0xf2, 0x41, 0x0f, 0x11, 0x40, 0x38, 0xe9,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+static const Jit_Hole stencil_for_loop_holes[] = {
+    {58, JIT_HOLE_TARGET, 4, -4},
+    {84, JIT_HOLE_EXIT, 4, -4},
+    {116, JIT_HOLE_EXIT, 4, -4},
+    {180, JIT_HOLE_TARGET, 4, -4},
+};
+
+static const u8 stencil_get_table_int_code[] = {
+    0x41, 0x80, 0x39, 0x05, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8b,
+    0x41, 0x08, 0x41, 0x80, 0x38, 0x0b, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00,
+    0x49, 0x8b, 0x48, 0x08, 0x48, 0x83, 0xe9, 0x01, 0x48, 0x3b, 0x88, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x48, 0xc1, 0xe1,
+    0x04, 0x48, 0x03, 0x88, 0x00, 0x00, 0x00, 0x00, 0x80, 0x39, 0x00, 0x75,
+    0x0e, 0x48, 0x83, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x85, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x10, 0x01, 0x0f, 0x11, 0x87, 0x00, 0x00, 0x00,
+    0x00,
+};
+
+static const Jit_Hole stencil_get_table_int_holes[] = {
+    {6, JIT_HOLE_EXIT, 4, -4},
+    {20, JIT_HOLE_EXIT, 4, -4},
+    {35, JIT_HOLE_TABLE_LENGTH, 4, 0},
+    {41, JIT_HOLE_EXIT, 4, -4},
+    {52, JIT_HOLE_TABLE_ARRAY, 4, 0},
+    {64, JIT_HOLE_TABLE_METATABLE, 4, 0},
+    {71, JIT_HOLE_EXIT, 4, -4},
+    {81, JIT_HOLE_RA, 4, 0},
+};
+
+static const u8 stencil_set_table_int_code[] = {
+    0x80, 0xbf, 0x00, 0x00, 0x00, 0x00, 0x05, 0x0f, 0x85, 0x00, 0x00, 0x00,
+    0x00, 0x48, 0x8b, 0x87, 0x00, 0x00, 0x00, 0x00, 0x41, 0x80, 0x38, 0x0b,
+    0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x49, 0x8b, 0x48, 0x08, 0x48, 0x83,
+    0xe9, 0x01, 0x48, 0x3b, 0x88, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x83, 0x00,
+    0x00, 0x00, 0x00, 0x48, 0xc1, 0xe1, 0x04, 0x48, 0x03, 0x88, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0x39, 0x00, 0x75, 0x0e, 0x48, 0x83, 0xb8, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0f, 0x85, 0x00, 0x00, 0x00, 0x00, 0x41, 0x0f, 0x10,
+    0x01, 0x0f, 0x11, 0x01,
+};
+
+static const Jit_Hole stencil_set_table_int_holes[] = {
+    {2, JIT_HOLE_RA, 4, 0},
+    {9, JIT_HOLE_EXIT, 4, -4},
+    {16, JIT_HOLE_RA, 4, 8},
+    {26, JIT_HOLE_EXIT, 4, -4},
+    {41, JIT_HOLE_TABLE_LENGTH, 4, 0},
+    {47, JIT_HOLE_EXIT, 4, -4},
+    {58, JIT_HOLE_TABLE_ARRAY, 4, 0},
+    {70, JIT_HOLE_TABLE_METATABLE, 4, 0},
+    {77, JIT_HOLE_EXIT, 4, -4},
+};
+
+static const Jit_Stencil jit_stencils[] = {
+    {stencil_entry_code, count_of(stencil_entry_code),
+     nullptr, 0},
+    {stencil_exit_code, count_of(stencil_exit_code),
+     stencil_exit_holes, count_of(stencil_exit_holes)},
+    {stencil_load_left_reg_code, count_of(stencil_load_left_reg_code),
+     stencil_load_left_reg_holes, count_of(stencil_load_left_reg_holes)},
+    {stencil_load_left_k_code, count_of(stencil_load_left_k_code),
+     stencil_load_left_k_holes, count_of(stencil_load_left_k_holes)},
+    {stencil_load_right_reg_code, count_of(stencil_load_right_reg_code),
+     stencil_load_right_reg_holes, count_of(stencil_load_right_reg_holes)},
+    {stencil_load_right_k_code, count_of(stencil_load_right_k_code),
+     stencil_load_right_k_holes, count_of(stencil_load_right_k_holes)},
+    {stencil_load_left_upvalue_code, count_of(stencil_load_left_upvalue_code),
+     stencil_load_left_upvalue_holes,
+     count_of(stencil_load_left_upvalue_holes)},
+    {stencil_move_code, count_of(stencil_move_code),
+     stencil_move_holes, count_of(stencil_move_holes)},
+    {stencil_set_upvalue_code, count_of(stencil_set_upvalue_code),
+     stencil_set_upvalue_holes, count_of(stencil_set_upvalue_holes)},
+    {stencil_nil_code, count_of(stencil_nil_code),
+     stencil_nil_holes, count_of(stencil_nil_holes)},
+    {stencil_bool_code, count_of(stencil_bool_code),
+     stencil_bool_holes, count_of(stencil_bool_holes)},
+    {stencil_jump_code, count_of(stencil_jump_code),
+     stencil_jump_holes, count_of(stencil_jump_holes)},
+    {stencil_add_code, count_of(stencil_add_code),
+     stencil_add_holes, count_of(stencil_add_holes)},
+    {stencil_sub_code, count_of(stencil_sub_code),
+     stencil_sub_holes, count_of(stencil_sub_holes)},
+    {stencil_mul_code, count_of(stencil_mul_code),
+     stencil_mul_holes, count_of(stencil_mul_holes)},
+    {stencil_div_code, count_of(stencil_div_code),
+     stencil_div_holes, count_of(stencil_div_holes)},
+    {stencil_mod_code, count_of(stencil_mod_code),
+     stencil_mod_holes, count_of(stencil_mod_holes)},
+    {stencil_unm_code, count_of(stencil_unm_code),
+     stencil_unm_holes, count_of(stencil_unm_holes)},
+    {stencil_not_code, count_of(stencil_not_code),
+     stencil_not_holes, count_of(stencil_not_holes)},
+    {stencil_truthy_code, count_of(stencil_truthy_code),
+     nullptr, 0},
+    {stencil_eq_code, count_of(stencil_eq_code),
+     nullptr, 0},
+    {stencil_lt_code, count_of(stencil_lt_code),
+     stencil_lt_holes, count_of(stencil_lt_holes)},
+    {stencil_leq_code, count_of(stencil_leq_code),
+     stencil_leq_holes, count_of(stencil_leq_holes)},
+    {stencil_branch_true_code, count_of(stencil_branch_true_code),
+     stencil_branch_true_holes, count_of(stencil_branch_true_holes)},
+    {stencil_branch_false_code, count_of(stencil_branch_false_code),
+     stencil_branch_false_holes, count_of(stencil_branch_false_holes)},
+    {stencil_skip_true_code, count_of(stencil_skip_true_code),
+     stencil_skip_true_holes, count_of(stencil_skip_true_holes)},
+    {stencil_skip_false_code, count_of(stencil_skip_false_code),
+     stencil_skip_false_holes, count_of(stencil_skip_false_holes)},
+    {stencil_for_loop_code, count_of(stencil_for_loop_code),
+     stencil_for_loop_holes, count_of(stencil_for_loop_holes)},
+    {stencil_get_table_int_code, count_of(stencil_get_table_int_code),
+     stencil_get_table_int_holes, count_of(stencil_get_table_int_holes)},
+    {stencil_set_table_int_code, count_of(stencil_set_table_int_code),
+     stencil_set_table_int_holes, count_of(stencil_set_table_int_holes)},
+};
@@ -139,6 +139,36 @@ base_print(lulu_VM *L)
 }
 
 static int
+base_error(lulu_VM *L)
+{
+    lulu_Integer level = lulu_opt_integer(L, 2, 1);
+    lulu_check_string(L, 1);
+    lulu_set_top(L, 1);
+    if (level > 0) {
+        lulu_where(L, static_cast<int>(level)); /* msg, where */
+        lulu_insert(L, 1);                      /* where, msg */
+        lulu_concat(L, 2);                      /* where .. msg */
+    }
+    return lulu_error(L);
+}
+
+/* Not static: see `vm.hpp`. */
+int
+base_pcall(lulu_VM *L)
+{
+    lulu_check_any(L, 1);
+    if (lulu_pcall(L, lulu_get_top(L) - 1, LULU_MULTRET) != LULU_OK) {
+        lulu_push_boolean(L, 0);
+        lulu_insert(L, -2); /* false, msg */
+        return 2;
+    }
+    lulu_push_boolean(L, 1);
+    lulu_insert(L, 1); /* true, ... */
+    return lulu_get_top(L);
+}
+
+/* Not static: see `vm.hpp`. */
+int
 base_next(lulu_VM *L)
 {
     lulu_check_type(L, 1, LULU_TYPE_TABLE);
@@ -162,7 +192,8 @@ base_pairs(lulu_VM *L)
     return 3;
 }
 
-static int
+/* Not static: see `vm.hpp`. */
+int
 ipairs_next(lulu_VM *L)
 {
     lulu_Integer i;
@@ -195,7 +226,8 @@ push_iterator(lulu_VM *L, const char *name, lulu_CFunction f)
     lulu_set_field(L, -2, name); /* _G ; _G[name] = f */
 }
 
-static int
+/* Not static: see `vm.hpp`. */
+int
 range_iterator(lulu_VM *L)
 {
     lulu_Number state   = lulu_check_number(L, 1);
@@ -284,10 +316,16 @@ static const lulu_Register baselib[] = {
     {"tostring", base_tostring},
     {"print", base_print},
     {"assert", base_assert},
+    {"error", base_error},
+    {"pcall", base_pcall},
+    {"range", base_range},
+};
+
+/* These never call back into Lua. */
+static const lulu_Register baselib_light[] = {
     {"tonumber", base_tonumber},
     {"type", base_type},
     {"next", base_next},
-    {"range", base_range},
     {"rawget", base_rawget},
     {"rawset", base_rawset},
     {"getmetatable", base_getmetatable},
@@ -300,6 +338,7 @@ lulu_open_base(lulu_VM *L)
     lulu_push_value(L, LULU_GLOBALS_INDEX); /* _G */
     lulu_set_global(L, "_G");               /* ; _G["_G"] = _G */
     lulu_set_library(L, "_G", baselib);     /* _G */
+    lulu_set_light_library(L, NULL, baselib_light);
 
     /* Save memory by reusing global 'next' */
     lulu_get_field(L, -1, "next");
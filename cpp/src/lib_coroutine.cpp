@@ -0,0 +1,148 @@
+#include "lulu_auxlib.h"
+
+static lulu_VM *
+get_coroutine(lulu_VM *L)
+{
+    lulu_VM *co = lulu_to_thread(L, 1);
+    lulu_arg_check(L, co != NULL, 1, "coroutine expected");
+    return co;
+}
+
+/**
+ * @return
+ *      The number of values yielded or returned by `co`, now moved to `L`,
+ *      or -1 if it could not be resumed or threw an error. In that case the
+ *      error message was moved instead.
+ *
+ * @note(2025-09-18)
+ *      Analogous to `lbaselib.c:auxresume()` in Lua 5.1.5.
+ */
+static int
+aux_resume(lulu_VM *L, lulu_VM *co, int n_args)
+{
+    if (!lulu_check_stack(co, n_args)) {
+        lulu_push_literal(L, "Too many arguments to resume");
+        return -1;
+    }
+    /* Finished, with its results already moved out? */
+    if (lulu_status(co) == LULU_OK && lulu_get_top(co) == 0) {
+        lulu_push_literal(L, "Cannot resume dead coroutine");
+        return -1;
+    }
+
+    lulu_xmove(L, co, n_args);
+    lulu_Error e = lulu_resume(co, L, n_args);
+    if (e == LULU_OK || e == LULU_YIELD) {
+        int n_results = lulu_get_top(co);
+        if (!lulu_check_stack(L, n_results)) {
+            lulu_push_literal(L, "Too many results to resume");
+            return -1;
+        }
+        lulu_xmove(co, L, n_results);
+        return n_results;
+    }
+    /* Error message. */
+    lulu_xmove(co, L, 1);
+    return -1;
+}
+
+static int
+coroutine_create(lulu_VM *L)
+{
+    lulu_check_type(L, 1, LULU_TYPE_FUNCTION);
+    lulu_VM *co = lulu_new_thread(L); /* f, co */
+    lulu_push_value(L, 1);            /* f, co, f */
+    lulu_xmove(L, co, 1);             /* f, co */
+    return 1;
+}
+
+static int
+coroutine_resume(lulu_VM *L)
+{
+    lulu_VM *co = get_coroutine(L);
+    int n_results = aux_resume(L, co, lulu_get_top(L) - 1);
+    if (n_results < 0) {
+        lulu_push_boolean(L, 0);
+        lulu_insert(L, -2); /* false, msg */
+        return 2;
+    }
+    lulu_push_boolean(L, 1);
+    lulu_insert(L, -(n_results + 1)); /* true, ... */
+    return n_results + 1;
+}
+
+static int
+coroutine_yield(lulu_VM *L)
+{
+    return lulu_yield(L, lulu_get_top(L));
+}
+
+/* Propagates errors, rather than returning them as `coroutine.resume()`. */
+static int
+wrap_call(lulu_VM *L)
+{
+    lulu_VM *co = lulu_to_thread(L, lulu_upvalue_index(1));
+    int n_results = aux_resume(L, co, lulu_get_top(L));
+    if (n_results < 0) {
+        return lulu_error(L);
+    }
+    return n_results;
+}
+
+static int
+coroutine_wrap(lulu_VM *L)
+{
+    coroutine_create(L);
+    lulu_push_cclosure(L, wrap_call, 1);
+    return 1;
+}
+
+static int
+coroutine_status(lulu_VM *L)
+{
+    lulu_VM *co = get_coroutine(L);
+    lulu_Debug ar;
+    if (co == L) {
+        lulu_push_literal(L, "running");
+    } else if (lulu_status(co) == LULU_YIELD) {
+        lulu_push_literal(L, "suspended");
+    } else if (lulu_status(co) != LULU_OK) {
+        lulu_push_literal(L, "dead");
+    } else if (lulu_get_stack(co, 0, &ar)) {
+        /* Resumed another coroutine, and is waiting on it. */
+        lulu_push_literal(L, "normal");
+    } else if (lulu_get_top(co) == 0) {
+        lulu_push_literal(L, "dead");
+    } else {
+        /* Not yet started. */
+        lulu_push_literal(L, "suspended");
+    }
+    return 1;
+}
+
+/* Like in Lua 5.1, there is no coroutine object for the main thread. */
+static int
+coroutine_running(lulu_VM *L)
+{
+    if (lulu_push_thread(L)) {
+        lulu_pop(L, 1);
+        lulu_push_nil(L);
+    }
+    return 1;
+}
+
+static const lulu_Register coroutine_library[] = {
+    {"create", coroutine_create},
+    {"resume", coroutine_resume},
+    {"yield", coroutine_yield},
+    {"wrap", coroutine_wrap},
+    {"status", coroutine_status},
+    {"running", coroutine_running},
+};
+
+LULU_LIB_API int
+lulu_open_coroutine(lulu_VM *L)
+{
+    lulu_set_library(L, LULU_COROUTINE_LIB_NAME, coroutine_library);
+    return 1;
+}
@@ -21,6 +21,34 @@ math_fn2(lulu_VM *L)
     return 1;
 }
 
+/* Not static: see `vm.hpp`. */
+int
+math_abs(lulu_VM *L)
+{
+    return math_fn<fabs>(L);
+}
+
+/* Not static: see `vm.hpp`. */
+int
+math_ceil(lulu_VM *L)
+{
+    return math_fn<ceil>(L);
+}
+
+/* Not static: see `vm.hpp`. */
+int
+math_floor(lulu_VM *L)
+{
+    return math_fn<floor>(L);
+}
+
+/* Not static: see `vm.hpp`. */
+int
+math_sqrt(lulu_VM *L)
+{
+    return math_fn<sqrt>(L);
+}
+
 static int
 math_log(lulu_VM *L)
 {
@@ -36,14 +64,15 @@ math_log(lulu_VM *L)
     return 1;
 }
 
-static int
+/* Not static: see `vm.hpp`. */
+int
 math_max(lulu_VM *L)
 {
     int         n_args = lulu_get_top(L);
     lulu_Number m      = lulu_check_number(L, 1);
 
     // Check all succeeding arguments against the first one.
-    for (int i = 2; i < n_args; i++) {
+    for (int i = 2; i <= n_args; i++) {
         lulu_Number n = lulu_check_number(L, i);
         if (n > m) {
             m = n;
@@ -54,13 +83,14 @@ math_max(lulu_VM *L)
     return 1;
 }
 
-static int
+/* Not static: see `vm.hpp`. */
+int
 math_min(lulu_VM *L)
 {
     int         n_args = lulu_get_top(L);
     lulu_Number m      = lulu_check_number(L, 1);
 
-    for (int i = 2; i < n_args; i++) {
+    for (int i = 2; i <= n_args; i++) {
         lulu_Number n = lulu_check_number(L, i);
         if (n < m) {
             m = n;
@@ -107,18 +137,18 @@ math_ldexp(lulu_VM *L)
 }
 
 static const lulu_Register math_lib[] = {
-    {"abs", &math_fn<fabs>},
+    {"abs", &math_abs},
     {"acos", &math_fn<acos>},
     {"asin", &math_fn<asin>},
     {"atan", &math_fn<atan>},
     {"atan2", &math_fn2<atan2>},
     {"cbrt", &math_fn<cbrt>},
-    {"ceil", &math_fn<ceil>},
+    {"ceil", &math_ceil},
     {"cos", &math_fn<cos>},
     {"cosh", &math_fn<cosh>},
     {"exp", &math_fn<exp>},
     {"exp2", &math_fn<exp2>},
-    {"floor", &math_fn<floor>},
+    {"floor", &math_floor},
     {"fmod", &math_fn2<fmod>},
     {"frexp", &math_frexp},
     {"ldexp", &math_ldexp},
@@ -132,7 +162,7 @@ static const lulu_Register math_lib[] = {
     {"remainder", &math_fn2<remainder>},
     {"sin", &math_fn<sin>},
     {"sinh", &math_fn<sinh>},
-    {"sqrt", &math_fn<sqrt>},
+    {"sqrt", &math_sqrt},
     {"tan", &math_fn<tan>},
     {"tanh", &math_fn<tanh>},
 };
@@ -140,7 +170,8 @@ static const lulu_Register math_lib[] = {
 LULU_LIB_API int
 lulu_open_math(lulu_VM *L)
 {
-    lulu_set_library(L, LULU_MATH_LIB_NAME, math_lib);
+    /* None of these call back into Lua. */
+    lulu_set_light_library(L, LULU_MATH_LIB_NAME, math_lib);
 
     /* constants */
     lulu_push_number(L, M_E);
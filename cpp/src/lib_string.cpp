@@ -32,6 +32,11 @@ string_byte(lulu_VM *L)
 
     size_t start = resolve_index(lulu_opt_integer(L, 2, /*def=*/1), n);
     size_t stop  = resolve_index(lulu_opt_integer(L, 3, /*def=*/start), n);
+    if (start <= stop
+        && !lulu_check_stack(L, static_cast<int>(stop - start + 1)))
+    {
+        lulu_errorf(L, "string slice too long");
+    }
     /* Use `<=` because `stop` is inclusive. */
     for (i = start; i <= stop; i++) {
         lulu_push_number(L, static_cast<lulu_Number>(s[i]));
@@ -498,9 +503,12 @@ string_format(lulu_VM *L)
 
 static const lulu_Register stringlib[] = {
     {"byte", string_byte},
-    {"char", string_char},
     {"find", string_find},
-    {"format", string_format},
+    {"format", string_format}};
+
+/* These never call back into Lua. */
+static const lulu_Register stringlib_light[] = {
+    {"char", string_char},
     {"len", string_len},
     {"lower", string_lower},
     {"rep", string_rep},
@@ -511,6 +519,7 @@ LULU_LIB_API int
 lulu_open_string(lulu_VM *L)
 {
     lulu_set_library(L, LULU_STRING_LIB_NAME, stringlib);
+    lulu_set_light_library(L, NULL, stringlib_light);
     /* new metatable for strings */
     lulu_new_table(L, /*n_array=*/0, /*n_hash=*/1);
     lulu_push_literal(L, "");   /* string, {}, "" */
@@ -1,6 +1,6 @@
 #include <stdio.h>  /* fprintf */
 #include <stdlib.h> /* malloc, free */
-#include <string.h> /* strcspn */
+#include <string.h> /* strcspn, strcmp */
 
 #include "lulu.h"
 #include "lulu_auxlib.h"
@@ -131,8 +131,13 @@ reader_file(void *user_ptr, size_t *n)
     return (*n > 0) ? r->buffer : NULL;
 }
 
+/**
+ * @return
+ *  `EXIT_SUCCESS` if the main function of the script was pushed, else
+ *  `EXIT_FAILURE` after reporting the error.
+ */
 static int
-run_file(lulu_VM *L, const char *file_name)
+load_file(lulu_VM *L, const char *file_name)
 {
     Reader_File r;
     lulu_Error  e;
@@ -144,7 +149,7 @@ run_file(lulu_VM *L, const char *file_name)
     e = lulu_load(L, file_name, reader_file, &r);
     fclose(r.file);
     if (e == LULU_OK) {
-        return run(L);
+        return EXIT_SUCCESS;
     }
 
     /* @note(2025-08-31) Good place to check cpcall stack restoration! */
@@ -152,6 +157,46 @@ run_file(lulu_VM *L, const char *file_name)
     return EXIT_FAILURE;
 }
 
+static int
+run_file(lulu_VM *L, const char *file_name)
+{
+    if (load_file(L, file_name) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    return run(L);
+}
+
+static int
+writer_file(void *user_ptr, const void *data, size_t n)
+{
+    FILE *file = cast(FILE *) user_ptr;
+    return fwrite(data, 1, n, file) != n;
+}
+
+/* e.g. `lulu --aot script.lua script.cpp`; see `lulu_dump_aot()`. */
+static int
+dump_file(lulu_VM *L, const char *file_name, const char *output_name)
+{
+    FILE *output;
+    int   status;
+    if (load_file(L, file_name) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    output = fopen(output_name, "w");
+    if (output == NULL) {
+        fprintf(stderr, "Failed to open file '%s'.\n", output_name);
+        return EXIT_FAILURE;
+    }
+    status = lulu_dump_aot(L, writer_file, output);
+    if (fclose(output) != 0 || status != 0) {
+        fprintf(stderr, "Failed to write file '%s'.\n", output_name);
+        return EXIT_FAILURE;
+    }
+    lulu_pop(L, 1); /* Remove main function from stack. */
+    return EXIT_SUCCESS;
+}
+
 typedef struct {
     char **argv;
     int    argc;
@@ -178,14 +223,50 @@ protected_main(lulu_VM *L)
     case 2:
         d->status = run_file(L, d->argv[1]);
         break;
+    case 4:
+        if (strcmp(d->argv[1], "--aot") == 0) {
+            d->status = dump_file(L, d->argv[2], d->argv[3]);
+            break;
+        } else if (strcmp(d->argv[1], "--native") == 0) {
+            /* Throws if the library cannot be loaded. */
+            lulu_load_aot(L, d->argv[2]);
+            d->status = run_file(L, d->argv[3]);
+            break;
+        }
+        /* fallthrough */
     default:
-        fprintf(stderr, "Usage: %s [script]\n", d->argv[0]);
+        fprintf(stderr,
+            "Usage: %s [script]\n"
+            "       %s --aot script output.cpp\n"
+            "       %s --native library.so script\n",
+            d->argv[0], d->argv[0], d->argv[0]);
         d->status = EXIT_FAILURE;
         break;
     }
     return 0;
 }
 
+typedef struct {
+    int budget;
+    int thrown;
+} Budget_Data;
+
+/**
+ * @brief
+ *  Throws once the budget set from `LULU_BUDGET` runs out, then allows all of
+ *  it again at the next call or loop iteration. That is only reached once the
+ *  error was caught, so a script can check that each of its runaway loops is
+ *  stopped, e.g. `tests/budget.lua`.
+ */
+static int
+budget_handler(lulu_VM *L, void *user_ptr)
+{
+    Budget_Data *b = cast(Budget_Data *) user_ptr;
+    cast(void)L;
+    b->thrown = !b->thrown;
+    return (b->thrown) ? 0 : b->budget;
+}
+
 static void *
 c_allocator(void *user_data, void *ptr, size_t old_size, size_t new_size)
 {
@@ -211,9 +292,12 @@ panic(lulu_VM *L)
 int
 main(int argc, char *argv[])
 {
-    Main_Data  d;
-    lulu_VM   *L;
-    lulu_Error e;
+    Main_Data   d;
+    lulu_VM    *L;
+    lulu_Error  e;
+    const char *jit;
+    const char *budget;
+    Budget_Data budget_data;
 
     /* In C89, brace initialization requires all constant expressions. */
     d.argv   = argv;
@@ -227,6 +311,20 @@ main(int argc, char *argv[])
     }
     lulu_set_panic(L, panic);
 
+    /* e.g. `LULU_JIT=0 lulu script.lua` to compare against the interpreter. */
+    jit = getenv("LULU_JIT");
+    if (jit != NULL && strcmp(jit, "0") == 0) {
+        lulu_set_jit(L, 0);
+    }
+
+    /* e.g. `LULU_BUDGET=1000000 lulu script.lua` to stop runaway loops. */
+    budget = getenv("LULU_BUDGET");
+    if (budget != NULL) {
+        budget_data.budget = atoi(budget);
+        budget_data.thrown = 0;
+        lulu_set_budget(L, budget_data.budget, budget_handler, &budget_data);
+    }
+
     /* Testing to see if panic works. */
     /* lulu_check_string(L, 1); */
 
@@ -88,11 +88,23 @@ typedef int (*lulu_CFunction)(lulu_VM *L);
 typedef const char *(*lulu_Reader)(void *user_ptr, size_t *n);
 
 
+/** @brief The counterpart of `lulu_Reader`, used by `lulu_dump_aot()`.
+ *
+ * @param data
+ *  The next `n` bytes to be written out. Only valid during this call.
+ *
+ * @return
+ *  0 on success, or any other value to stop writing.
+ */
+typedef int (*lulu_Writer)(void *user_ptr, const void *data, size_t n);
+
+
 /** @brief(2025-06-11) Chapter 15.1.1 of Crafting Interpreters: "Executing
  *  instructions".
  */
 typedef enum {
     LULU_OK,
+    LULU_YIELD, /* A coroutine is suspended; see `lulu_yield()`. */
     LULU_ERROR_SYNTAX,
     LULU_ERROR_RUNTIME,
     LULU_ERROR_MEMORY
@@ -111,7 +123,8 @@ typedef enum {
     LULU_TYPE_STRING,
     LULU_TYPE_TABLE,
     LULU_TYPE_FUNCTION, /* A Lua or C function. */
-    LULU_TYPE_USERDATA /* Full userdata: collectible, may have metatable. */
+    LULU_TYPE_USERDATA, /* Full userdata: collectible, may have metatable. */
+    LULU_TYPE_THREAD /* A coroutine, with its own stack. */
 } lulu_Type;
 
 LULU_API lulu_VM *
@@ -128,12 +141,170 @@ LULU_API void
 lulu_close(lulu_VM *L);
 
 
+/** @brief Sets the maximum number of active function calls, Lua or C, at any
+ *  one time. Calls past this limit throw an error. The default is
+ *  `LULU_MAX_CALLS`.
+ *
+ * @return
+ *  The previous limit.
+ */
+LULU_API int
+lulu_set_call_limit(lulu_VM *L, int limit);
+
+
+/** @brief Enables or disables compiling hot Lua functions to native code.
+ *  While disabled, functions which were already compiled are interpreted
+ *  instead. Enabling it does nothing if the library was built without
+ *  `LULU_JIT`.
+ *
+ * @return
+ *  1 if it was previously enabled, else 0.
+ */
+LULU_API int
+lulu_set_jit(lulu_VM *L, int enable);
+
+
+/** @brief Called when the budget set by `lulu_set_budget()` runs out.
+ *
+ * @param user_ptr
+ *  The `handler_data` given to `lulu_set_budget()`.
+ *
+ * @return
+ *  How many more calls and loop iterations to allow, or 0 (or less) to throw
+ *  a runtime error instead.
+ */
+typedef int (*lulu_Budget_Handler)(lulu_VM *L, void *user_ptr);
+
+
+/** @brief Limits how long Lua code may run for. Every call made from Lua, and
+ *  every backward jump (i.e. every loop iteration), uses up 1 unit of
+ *  `budget`. The budget is shared by all threads of `L`.
+ *
+ * @details
+ *  Once it runs out, `handler` is called if it is not `NULL`, and may allow
+ *  more. Otherwise a runtime error is thrown. The budget then stays exhausted,
+ *  so a script which catches the error is stopped again at its next call or
+ *  loop iteration, until `lulu_set_budget()` is called again.
+ *
+ *  While a budget is set, native code is not entered, as it may loop without
+ *  returning to the interpreter.
+ *
+ * @param budget
+ *  The number of calls and backward jumps to allow, or 0 (or less) to remove
+ *  the budget.
+ *
+ * @return
+ *  What was left of the previous budget, or -1 if there was none.
+ */
+LULU_API int
+lulu_set_budget(lulu_VM *L, int budget, lulu_Budget_Handler handler,
+    void *handler_data);
+
+
+/** @brief Creates a new thread (coroutine) sharing the global state and
+ *  globals table of `L`.
+ *
+ * @details [POPPED: -0, PUSHED: +1, ERRORS: memory]
+ *
+ *  The thread has its own stack, and is collected like any other object once
+ *  it is no longer reachable.
+ */
+LULU_API lulu_VM *
+lulu_new_thread(lulu_VM *L);
+
+
+/** @brief Starts or resumes the coroutine `L`.
+ *
+ * @details [POPPED: -(n_args), PUSHED: +(n_rets or 1 if caught),
+ *  ERRORS: none]
+ *
+ *  To start a coroutine, push its main function then its arguments onto its
+ *  own stack. To resume a suspended one, push only the values to be returned
+ *  from its call to `lulu_yield()`.
+ *
+ * @param from
+ *  The thread doing the resuming, or `NULL`. Used to count nested C calls.
+ *
+ * @return
+ *  `LULU_YIELD` if the coroutine yielded, `LULU_OK` if its main function
+ *  returned, or else the error code of the error it threw. The values yielded
+ *  or returned, or the error message, are then all that is on its stack.
+ */
+LULU_API lulu_Error
+lulu_resume(lulu_VM *L, lulu_VM *from, int n_args);
+
+
+/** @brief Suspends the running coroutine, handing the top `n_results`
+ *  values to `lulu_resume()`. Must only be used as the return expression of a
+ *  C function, i.e. `return lulu_yield(L, n_results);`.
+ *
+ * @details [POPPED: -0, PUSHED: +0, ERRORS: runtime]
+ *
+ *  When the coroutine is next resumed, the C function returns the resume
+ *  arguments to its caller.
+ *
+ * @note(2025-09-18)
+ *  Throws if `L` is the main thread, or if there is a C call (e.g. a
+ *  metamethod or `lulu_call()`) between the C function and the last resume.
+ */
+LULU_API int
+lulu_yield(lulu_VM *L, int n_results);
+
+
+/** @return The status of thread `L`: `LULU_OK` if it is running, not yet
+ *  started, or finished; `LULU_YIELD` if suspended; or the error code of the
+ *  error it died from.
+ */
+LULU_API lulu_Error
+lulu_status(lulu_VM *L);
+
+
+/** @brief Pops `n` values from `from`, and pushes them onto `to`. Both must
+ *  share the same global state.
+ *
+ * @details [POPPED: -(n) from `from`, PUSHED: +(n) onto `to`, ERRORS: none]
+ */
+LULU_API void
+lulu_xmove(lulu_VM *from, lulu_VM *to, int n);
+
+
 /** @brief Compiles the script read in by `reader` into a Lua function. */
 LULU_API lulu_Error
 lulu_load(lulu_VM *L, const char *source, lulu_Reader reader,
     void *reader_data);
 
 
+/** @brief Writes out the Lua function at the top of the stack, and all the
+ *  functions nested in it, as C++ source code.
+ *
+ * @details [POPPED: -0, PUSHED: +0, ERRORS: none]
+ *
+ *  The source must be compiled into a shared library against the same
+ *  headers and configuration as this library. Once loaded with
+ *  `lulu_load_aot()`, every later `lulu_load()` of the same script runs the
+ *  compiled code instead of interpreting it where possible.
+ *
+ * @return
+ *  0 on success, 1 if the value is not a Lua function or the library was
+ *  built without `LULU_AOT`, or else whatever nonzero value `writer`
+ *  returned.
+ */
+LULU_API int
+lulu_dump_aot(lulu_VM *L, lulu_Writer writer, void *writer_data);
+
+
+/** @brief Loads a shared library made from the output of `lulu_dump_aot()`.
+ *
+ * @details [POPPED: -0, PUSHED: +0, ERRORS: runtime, memory]
+ *
+ *  Functions compiled by later calls to `lulu_load()` use the code in the
+ *  library if they are identical to the ones it was generated from. Others
+ *  are interpreted as usual. The library stays loaded until `lulu_close()`.
+ */
+LULU_API void
+lulu_load_aot(lulu_VM *L, const char *file_name);
+
+
 /** @brief Calls a Lua or C function. Assumes stack has arguments you need.
  *
  * @details [POPPED: -(n_args + 1), PUSHED: +(n_rets), ERRORS: any]
@@ -316,11 +487,30 @@ LULU_API void *
 lulu_to_pointer(lulu_VM *L, int i);
 
 
+/** @return The thread at index `i`, or else `NULL`. */
+LULU_API lulu_VM *
+lulu_to_thread(lulu_VM *L, int i);
+
+
 /*=== }}} =============================================================== */
 
 /*=== STACK MANIPULATION FUNCTIONS ================================= {{{ */
 
 
+/** @brief Ensures there are at least `n` free stack slots past the top.
+ *
+ * @return
+ *  Nonzero if the stack could be grown as needed, else 0 if it would exceed
+ *  its maximum size.
+ *
+ * @note(2025-09-17)
+ *  Only `LULU_STACK_MIN` slots are guaranteed for C functions. Call this
+ *  beforehand if you need to push more than that.
+ */
+LULU_API int
+lulu_check_stack(lulu_VM *L, int n);
+
+
 /** @brief Query the number of elements in the current stack frame. */
 LULU_API int
 lulu_get_top(lulu_VM *L);
@@ -436,11 +626,33 @@ lulu_push_cclosure(lulu_VM *L, lulu_CFunction cf, int n_upvalues);
 #define lulu_push_cfunction(vm, cf) lulu_push_cclosure(vm, cf, 0)
 
 
+/** @brief Pushes `cf` as a 'light' `function` value with no upvalues.
+ *
+ * @details
+ *      Calls to light functions from Lua skip most of the bookkeeping of a
+ *      C call: their results are moved straight into the caller's registers.
+ *      In return, `cf` must never call into Lua, be it directly with
+ *      `lulu_call()` and friends or through metamethods, nor yield. Like any
+ *      other C function it may use up to `LULU_STACK_MIN` stack slots, throw
+ *      errors and allocate.
+ */
+LULU_API void
+lulu_push_light_function(lulu_VM *L, lulu_CFunction cf);
+
+
 /** @brief Pushes a copy of relative/pseudo stack index `i`. */
 LULU_API void
 lulu_push_value(lulu_VM *L, int i);
 
 
+/** @brief Pushes thread `L` onto its own stack.
+ *
+ * @return 1 if `L` is the main thread, else 0.
+ */
+LULU_API int
+lulu_push_thread(lulu_VM *L);
+
+
 /*=== }}} =============================================================== */
 
 
@@ -721,6 +933,10 @@ lulu_gc(lulu_VM *L, lulu_GC_Mode mode);
 #define lulu_is_function(vm, i) (lulu_type(vm, i) == LULU_TYPE_FUNCTION)
 
 
+/** @return 1 if stack index `i` is a `thread`, else 0. */
+#define lulu_is_thread(vm, i) (lulu_type(vm, i) == LULU_TYPE_THREAD)
+
+
 /** @brief Ignore out parameter for length. All Lulu strings are C strings. */
 #define lulu_to_string(vm, i) lulu_to_lstring(vm, i, NULL)
 
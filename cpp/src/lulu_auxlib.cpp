@@ -209,6 +209,10 @@ lulu_arg_error(lulu_VM *L, int argn, const char *msg)
     }
     lulu_get_info(L, "nu", &ar);
     argn = resolve_index(L, &ar, argn, &what);
+    // No name when called directly by another C function, e.g. `pcall(error)`.
+    if (ar.name == nullptr) {
+        ar.name = "?";
+    }
     return lulu_errorf(L, "Bad %s #%i to '%s' (%s)", what, argn, ar.name, msg);
 }
 
@@ -354,9 +358,9 @@ lulu_errorf(lulu_VM *L, const char *fmt, ...)
     return lulu_error(L);
 }
 
-LULU_LIB_API void
-lulu_set_nlibrary(lulu_VM *L, const char *libname,
-    const lulu_Register *library, int n)
+static void
+set_library(lulu_VM *L, const char *libname, const lulu_Register *library,
+    int n, bool light)
 {
     if (libname != nullptr) {
         lulu_get_global(L, libname);
@@ -373,11 +377,29 @@ lulu_set_nlibrary(lulu_VM *L, const char *libname,
     }
 
     for (int i = 0; i < n; i++) {
-        lulu_push_cfunction(L, library[i].function);
+        if (light) {
+            lulu_push_light_function(L, library[i].function);
+        } else {
+            lulu_push_cfunction(L, library[i].function);
+        }
         lulu_set_field(L, -2, library[i].name);
     }
 }
 
+LULU_LIB_API void
+lulu_set_nlibrary(lulu_VM *L, const char *libname,
+    const lulu_Register *library, int n)
+{
+    set_library(L, libname, library, n, /*light=*/false);
+}
+
+LULU_LIB_API void
+lulu_set_light_nlibrary(lulu_VM *L, const char *libname,
+    const lulu_Register *library, int n)
+{
+    set_library(L, libname, library, n, /*light=*/true);
+}
+
 LULU_LIB_API int
 lulu_new_metatable(lulu_VM *L, const char *mt_name)
 {
@@ -404,6 +426,7 @@ static const lulu_Register libs[] = {
     {LULU_TABLE_LIB_NAME, lulu_open_table},
     {LULU_OS_LIB_NAME, lulu_open_os},
     {LULU_IO_LIB_NAME, lulu_open_io},
+    {LULU_COROUTINE_LIB_NAME, lulu_open_coroutine},
 };
 
 LULU_LIB_API void
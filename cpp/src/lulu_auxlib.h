@@ -144,6 +144,13 @@ LULU_LIB_API const char *
 lulu_opt_lstring(lulu_VM *L, int argn, const char *def, size_t *n);
 
 
+/** @brief Pushes `"source:line: "` for the function at call stack `level`,
+ *  or an empty string if it is not known. Level 0 is the running function.
+ */
+LULU_LIB_API void
+lulu_where(lulu_VM *L, int level);
+
+
 LULU_LIB_API int LULU_ATTR_PRINTF(2, 3)
 lulu_errorf(lulu_VM *L, const char *fmt, ...);
 
@@ -165,6 +172,14 @@ lulu_set_nlibrary(lulu_VM *L, const char *libname,
     const lulu_Register *library, int n);
 
 
+/** @brief Like `lulu_set_nlibrary()`, but all functions in `library` are
+ *  registered as light functions. See `lulu_push_light_function()`.
+ */
+LULU_LIB_API void
+lulu_set_light_nlibrary(lulu_VM *L, const char *libname,
+    const lulu_Register *library, int n);
+
+
 /** @brief Create `registry[mt_name]` if it does not exist already. */
 LULU_LIB_API int
 lulu_new_metatable(lulu_VM *L, const char *mt_name);
@@ -204,6 +219,9 @@ lulu_new_metatable(lulu_VM *L, const char *mt_name);
 #define lulu_set_library(vm, name, fns)                                        \
     lulu_set_nlibrary(vm, name, fns, lulu_count_library(fns))
 
+#define lulu_set_light_library(vm, name, fns)                                  \
+    lulu_set_light_nlibrary(vm, name, fns, lulu_count_library(fns))
+
 #define lulu_get_library_metatable(L, mt_name)  \
     lulu_get_field(L, LULU_REGISTRY_INDEX, mt_name)
 
@@ -230,4 +248,7 @@ lulu_open_os(lulu_VM *L);
 LULU_LIB_API int
 lulu_open_io(lulu_VM *L);
 
+LULU_LIB_API int
+lulu_open_coroutine(lulu_VM *L);
+
 #endif /* LULU_AUXILLIARY_H */
@@ -68,6 +68,26 @@
 #define LULU_MATH_LIB_NAME   "math"
 #define LULU_OS_LIB_NAME     "os"
 #define LULU_IO_LIB_NAME     "io"
+#define LULU_COROUTINE_LIB_NAME "coroutine"
+
+
+/**
+ * @brief CONFIG:
+ *      Default maximum number of active function calls, Lua or C, at any one
+ *      time. This limits how deep scripts may recurse. It can be changed at
+ *      runtime with `lulu_set_call_limit()`.
+ */
+#define LULU_MAX_CALLS 20000
+
+
+/**
+ * @brief CONFIG:
+ *      Maximum number of nested calls that recurse in C, e.g. metamethods,
+ *      `for` loop generators and functions called from the C API. Unlike
+ *      calls between Lua functions these each use up some of the C stack,
+ *      so this is much lower than `LULU_MAX_CALLS`.
+ */
+#define LULU_MAX_CCALLS 200
 
 
 /**
@@ -191,6 +211,105 @@
 #endif /* LULU_BUILD_ALL */
 
 
+/**
+ * @brief CONFIG:
+ *      When nonzero, `vm_execute()` uses 'threaded' dispatch: each opcode
+ *      handler jumps directly to the next handler via a table of label
+ *      addresses, rather than going back to a single `switch`. This requires
+ *      the GNU C labels-as-values extension, so other compilers always use the
+ *      `switch` fallback.
+ *
+ *      Define to 0 beforehand (e.g. `-DLULU_USE_COMPUTED_GOTO=0`) to force the
+ *      `switch` fallback, e.g. for comparison or debugging.
+ */
+#ifndef LULU_USE_COMPUTED_GOTO
+#   if defined(__GNUC__) || defined(__clang__)
+#       define LULU_USE_COMPUTED_GOTO 1
+#   else
+#       define LULU_USE_COMPUTED_GOTO 0
+#   endif
+#endif /* LULU_USE_COMPUTED_GOTO */
+
+
+/**
+ * @brief CONFIG:
+ *      When nonzero, errors are thrown with `longjmp()` and caught with
+ *      `setjmp()` rather than with C++ exceptions. Throwing is then only a
+ *      jump, without the unwinder searching tables for every frame in
+ *      between, which matters when `pcall()` is used for expected failures.
+ *      Analogous to `LUAI_THROW` and `LUAI_TRY` in Lua 5.1.5.
+ *
+ *      Define to 0 beforehand (e.g. `-DLULU_USE_LONGJMP=0`) to use C++
+ *      exceptions instead.
+ */
+#ifndef LULU_USE_LONGJMP
+#   define LULU_USE_LONGJMP 1
+#endif /* LULU_USE_LONGJMP */
+
+
+/**
+ * @brief CONFIG:
+ *      When nonzero, the internal `Value` type is 'NaN-boxed' into 8 bytes
+ *      rather than a separate type tag and payload, which is 16 bytes with
+ *      padding. This halves the size of the VM stack, table arrays and hash
+ *      entries.
+ *
+ *      This requires `lulu_Number` to be an IEEE-754 double and all pointers
+ *      (both objects and light userdata) to fit in 47 bits, as is the case
+ *      for user-space addresses on x86-64 and most AArch64 systems.
+ *
+ *      Define to 1 beforehand (e.g. `-DLULU_NAN_BOXING=1`) to enable it.
+ */
+#ifndef LULU_NAN_BOXING
+#   define LULU_NAN_BOXING 0
+#endif /* LULU_NAN_BOXING */
+
+
+/**
+ * @brief CONFIG:
+ *      When nonzero, Lua functions which are called often or loop many times
+ *      are compiled to native code. See `jit.hpp`. This is only supported on
+ *      x86-64 ELF platforms (e.g. Linux) with the tagged `Value` layout,
+ *      where it is enabled by default. It can still be switched off at
+ *      runtime with `lulu_set_jit()`.
+ *
+ *      Define to 0 beforehand (e.g. `-DLULU_JIT=0`) to not build it at all.
+ */
+#ifndef LULU_JIT
+#   if defined(__x86_64__) && defined(__ELF__) && !LULU_NAN_BOXING
+#       define LULU_JIT 1
+#   else
+#       define LULU_JIT 0
+#   endif
+#endif /* LULU_JIT */
+
+
+/**
+ * @brief CONFIG:
+ *      How many calls, returns and loop iterations a function must go through
+ *      before it is compiled, if `LULU_JIT` is nonzero.
+ */
+#define LULU_JIT_THRESHOLD 100
+
+
+/**
+ * @brief CONFIG:
+ *      When nonzero, Lua functions can be compiled ahead of time to C++ with
+ *      `lulu_dump_aot()`, built into a shared library, and then loaded with
+ *      `lulu_load_aot()`. See `aot.hpp`. This requires `dlopen()`, so it is
+ *      enabled by default only on Unix-like platforms.
+ *
+ *      Define to 0 beforehand (e.g. `-DLULU_AOT=0`) to not build it at all.
+ */
+#ifndef LULU_AOT
+#   if defined(__unix__) || defined(__APPLE__)
+#       define LULU_AOT 1
+#   else
+#       define LULU_AOT 0
+#   endif
+#endif /* LULU_AOT */
+
+
 #ifdef LULU_DEBUG
 /**
  * @brief Crafting Interpreters 26.2.1: Collecting Garbage
@@ -45,13 +45,15 @@ mem_ceil_log2(usize n)
 
     // Accumulator for values of n that do not fit in the lookup table.
     // We know that if it does not fit, 2^8 is automatically added on top.
-    // Concept check: ceil(log2(257))
-    int acc = 0;
-    while (n > 0x100) {
-        n >>= 8;
+    // Shift `n - 1` rather than `n` so that we round up to the next power
+    // of 2, not down. Concept check: ceil(log2(257)) == 9, not 8.
+    usize i   = n - 1;
+    int   acc = 0;
+    while (i >= 0x100) {
+        i >>= 8;
         acc += 8;
     }
-    return acc + ceil_log2_lookup_table[n - 1];
+    return acc + ceil_log2_lookup_table[i];
 }
 
 void *
@@ -26,15 +26,15 @@ mt_get_fast(lulu_VM *L, Table *mt, Metamethod m)
     }
 
     // Flag bit set is optimized for absence of metamethods.
-    if (mt->flags & (1u << m)) {
+    u16 bit = static_cast<u16>(1u << m);
+    if (mt->flags & bit) {
         return nil;
     }
 
     Value mf = table_get_string(mt, G(L)->mt_names[m]);
-    lulu_assert(MT_INDEX <= m && m <= MT_GC);
     // Metamethod not found? Cache this finding.
     if (mf.is_nil()) {
-        mt->flags |= (1u << m);
+        mt->flags |= bit;
     }
     return mf;
 }
@@ -54,9 +54,5 @@ mt_get_method(lulu_VM *L, Value v, Metamethod t)
         mt = G(L)->mt_basic[v.type()];
         break;
     }
-    if (mt == nullptr) {
-        return nil;
-    }
-    OString *k = G(L)->mt_names[t];
-    return table_get_string(mt, k);
+    return mt_get_fast(L, mt, t);
 }
@@ -16,14 +16,17 @@ enum Metamethod {
 
 #define MT_COUNT    (MT_LEQ + 1)
 
+static_assert(MT_COUNT <= 16, "`Table::flags` has one bit per metamethod");
+
 // Prevent infinite recursion.
 #define MT_MAX_LOOP 100
 
 extern const char *const mt_names[MT_COUNT];
 
+// Queries `mt[m]`, remembering in `mt->flags` if it is absent.
 Value
 mt_get_fast(lulu_VM *L, Table *mt, Metamethod m);
 
-// Queries `getmetatable(v)[t]`.
+// Queries `getmetatable(v)[t]`, like `mt_get_fast()`.
 Value
 mt_get_method(lulu_VM *L, Value v, Metamethod t);
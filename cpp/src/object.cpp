@@ -20,6 +20,7 @@ object_free(lulu_VM *L, Object *o)
     case VALUE_FUNCTION: closure_delete(L, &o->function); break;
     case VALUE_USERDATA: userdata_free(L, &o->userdata); break;
     case VALUE_UPVALUE: mem_free(L, &o->upvalue); break;
+    case VALUE_THREAD: thread_free(L, reinterpret_cast<lulu_VM *>(o)); break;
     default:
         lulu_panicf("Invalid object (Value_Type(%i))", t);
         break;
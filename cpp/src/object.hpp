@@ -88,6 +88,7 @@ Value::to_pointer() const
     case VALUE_TABLE:         return this->to_table();
     case VALUE_FUNCTION:      return this->to_function();
     case VALUE_USERDATA:      return this->to_userdata();
+    case VALUE_THREAD:        return this->to_object();
     default:
         break;
     }
@@ -131,8 +132,10 @@ inline T *
 object_new(lulu_VM *L, Object_List **list, Value_Type type, isize extra = 0)
 {
     T *o = mem_new<T>(L, extra);
-    // Not safe nor intuitive to zero-init flexible-arrays with `*o = {}`
-    memset(o, 0, size_of(*o) + extra);
+    // Not safe nor intuitive to zero-init flexible-arrays with `*o = {}`.
+    // Cast as some types, e.g. `lulu_VM`, are not trivially default
+    // constructible.
+    memset(static_cast<void *>(o), 0, size_of(*o) + extra);
 
     o->type = type;
 
@@ -8,42 +8,59 @@
  *      Vim: '<,>'s/\v(OP_)(\w+),/[\1\2] = "\L\2",/g
  */
 const char *const opnames[OPCODE_COUNT] = {
-    "move",        // OP_MOVE
-    "constant",    // OP_CONSTANT
-    "nil",         // OP_NIL
-    "bool",        // OP_BOOL
-    "get_global",  // OP_GET_GLOBAL
-    "set_global",  // OP_SET_GLOBAL
-    "new_table",   // OP_NEW_TABLE
-    "get_table",   // OP_GET_TABLE
-    "set_table",   // OP_SET_TABLE
-    "set_array",   // OP_SET_ARRAY
-    "get_upvalue", // OP_GET_UPVALUE
-    "set_upvalue", // OP_SET_UPVALUE
-    "add",         // OP_ADD
-    "sub",         // OP_SUB
-    "mul",         // OP_MUL
-    "div",         // OP_DIV
-    "mod",         // OP_MOD
-    "pow",         // OP_POW
-    "eq",          // OP_EQ
-    "lt",          // OP_LT
-    "leq",         // OP_LEQ
-    "unm",         // OP_UNM
-    "not",         // OP_NOT
-    "len",         // OP_LEN
-    "concat",      // OP_CONCAT
-    "test",        // OP_TEST
-    "test_set",    // OP_TEST_SET
-    "jump",        // OP_JUMP
-    "for_prep",    // OP_FOR_PREP
-    "for_loop",    // OP_FOR_LOOP
-    "for_in",      // OP_FOR_IN
-    "call",        // OP_CALL
-    "self",        // OP_SELF
-    "closure",     // OP_CLOSURE
-    "close",       // OP_CLOSE
-    "return",      // OP_RETURN
+    "move",          // OP_MOVE
+    "constant",      // OP_CONSTANT
+    "nil",           // OP_NIL
+    "bool",          // OP_BOOL
+    "get_global",    // OP_GET_GLOBAL
+    "set_global",    // OP_SET_GLOBAL
+    "new_table",     // OP_NEW_TABLE
+    "get_table",     // OP_GET_TABLE
+    "set_table",     // OP_SET_TABLE
+    "get_field",     // OP_GET_FIELD
+    "set_field",     // OP_SET_FIELD
+    "set_array",     // OP_SET_ARRAY
+    "get_upvalue",   // OP_GET_UPVALUE
+    "set_upvalue",   // OP_SET_UPVALUE
+    "add",           // OP_ADD
+    "sub",           // OP_SUB
+    "mul",           // OP_MUL
+    "div",           // OP_DIV
+    "mod",           // OP_MOD
+    "pow",           // OP_POW
+    "eq",            // OP_EQ
+    "lt",            // OP_LT
+    "leq",           // OP_LEQ
+    "unm",           // OP_UNM
+    "not",           // OP_NOT
+    "len",           // OP_LEN
+    "concat",        // OP_CONCAT
+    "test",          // OP_TEST
+    "test_set",      // OP_TEST_SET
+    "jump",          // OP_JUMP
+    "jump_if",       // OP_JUMP_IF
+    "jump_if_not",   // OP_JUMP_IF_NOT
+    "for_prep",      // OP_FOR_PREP
+    "for_loop",      // OP_FOR_LOOP
+    "for_in",        // OP_FOR_IN
+    "call",          // OP_CALL
+    "tail_call",     // OP_TAIL_CALL
+    "self",          // OP_SELF
+    "closure",       // OP_CLOSURE
+    "close",         // OP_CLOSE
+    "return",        // OP_RETURN
+    "call_math",     // OP_CALL_MATH
+    "add_num",       // OP_ADD_NUM
+    "sub_num",       // OP_SUB_NUM
+    "mul_num",       // OP_MUL_NUM
+    "div_num",       // OP_DIV_NUM
+    "mod_num",       // OP_MOD_NUM
+    "pow_num",       // OP_POW_NUM
+    "lt_num",        // OP_LT_NUM
+    "leq_num",       // OP_LEQ_NUM
+    "get_table_int", // OP_GET_TABLE_INT
+    "get_table_str", // OP_GET_TABLE_STR
+    "set_table_int", // OP_SET_TABLE_INT
 };
 
 static constexpr OpInfo
@@ -82,6 +99,8 @@ const OpInfo opinfo[OPCODE_COUNT] = {
     MAKE(ABC,  false, true,  OPARG_OTHER, OPARG_OTHER),  // OP_NEW_TABLE
     MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_GET_TABLE
     MAKE(ABC,  false, false, OPARG_REGK,  OPARG_REGK),   // OP_SET_TABLE
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_GET_FIELD
+    MAKE(ABC,  false, false, OPARG_REGK,  OPARG_REGK),   // OP_SET_FIELD
     MAKE(ABC,  false, true,  OPARG_OTHER, OPARG_OTHER),  // OP_SET_ARRAY
     MAKE(ABC,  false, true,  OPARG_REGK),                // OP_GET_UPVALUE
     MAKE(ABC,  false, false, OPARG_REGK),                // OP_SET_UPVALUE
@@ -101,16 +120,52 @@ const OpInfo opinfo[OPCODE_COUNT] = {
     MAKE(ABC,  true,  false, OPARG_UNUSED, OPARG_OTHER), // OP_TEST
     MAKE(ABC,  true,  true,  OPARG_REGK, OPARG_OTHER),   // OP_TEST_SET
     MAKE(ASBX, false, false, OPARG_JUMP),                // OP_JUMP
+    MAKE(ASBX, false, false, OPARG_JUMP),                // OP_JUMP_IF
+    MAKE(ASBX, false, false, OPARG_JUMP),                // OP_JUMP_IF_NOT
     MAKE(ASBX, true,  true,  OPARG_JUMP),                // OP_FOR_PREP
     MAKE(ASBX, true,  true,  OPARG_JUMP),                // OP_FOR_LOOP
     MAKE(ABC,  true,  false, OPARG_UNUSED, OPARG_REGK),  // OP_FOR_IN
     MAKE(ABC,  false, true,  OPARG_OTHER, OPARG_OTHER),  // OP_CALL
+    MAKE(ABC,  false, true,  OPARG_OTHER),               // OP_TAIL_CALL
     MAKE(ABC,  false, true,  OPARG_REGK, OPARG_REGK),    // OP_SELF
     MAKE(ABX,  false, true,  OPARG_REGK),                // OP_CLOSURE
     MAKE(ABC,  false, false, OPARG_UNUSED),              // OP_CLOSE
     MAKE(ABC,  false, false, OPARG_OTHER),               // OP_RETURN
+    MAKE(ABC,  false, true,  OPARG_OTHER, OPARG_OTHER),  // OP_CALL_MATH
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_ADD_NUM
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_SUB_NUM
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_MUL_NUM
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_DIV_NUM
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_MOD_NUM
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_POW_NUM
+    MAKE(ABC,  true,  false, OPARG_REGK,  OPARG_REGK),   // OP_LT_NUM
+    MAKE(ABC,  true,  false, OPARG_REGK,  OPARG_REGK),   // OP_LEQ_NUM
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_GET_TABLE_INT
+    MAKE(ABC,  false, true,  OPARG_REGK,  OPARG_REGK),   // OP_GET_TABLE_STR
+    MAKE(ABC,  false, false, OPARG_REGK,  OPARG_REGK),   // OP_SET_TABLE_INT
 };
 
+OpCode
+opcode_generic(OpCode op)
+{
+    switch (op) {
+    case OP_ADD_NUM:       return OP_ADD;
+    case OP_SUB_NUM:       return OP_SUB;
+    case OP_MUL_NUM:       return OP_MUL;
+    case OP_DIV_NUM:       return OP_DIV;
+    case OP_MOD_NUM:       return OP_MOD;
+    case OP_POW_NUM:       return OP_POW;
+    case OP_LT_NUM:        return OP_LT;
+    case OP_LEQ_NUM:       return OP_LEQ;
+    case OP_GET_TABLE_INT:
+    case OP_GET_TABLE_STR: return OP_GET_TABLE;
+    case OP_SET_TABLE_INT: return OP_SET_TABLE;
+    default:
+        break;
+    }
+    return op;
+}
+
 static constexpr unsigned int
 // 1-bits in 0b0000_0111
 FB_MANT_SIZE = 3,
@@ -13,6 +13,8 @@ enum OpCode : u8 {
     OP_NEW_TABLE,   // A B C | R(A) := {} ; #hash = B, #array = C
     OP_GET_TABLE,   // A B C | R(A) := R(B)[RK(C)]
     OP_SET_TABLE,   // A B C | R(A)[RK(B)] := RK(C)
+    OP_GET_FIELD,   // A B C | R(A) := R(B)[K(C)] ; K(C) is a string
+    OP_SET_FIELD,   // A B C | R(A)[K(B)] := RK(C) ; K(B) is a string
     OP_SET_ARRAY,   // A B C | R(A)[C*FPF + i] := R(A+i) for 1 <= i <= B
     OP_GET_UPVALUE, // A B   | R(A) := Upvalues[B]
     OP_SET_UPVALUE, // A B   | Upvalues[B] := R(A)
@@ -34,6 +36,8 @@ enum OpCode : u8 {
                     //         then R(A) := R(B)
                     //         else ip++
     OP_JUMP,        // sBx   | ip += sBx
+    OP_JUMP_IF,     // A sBx | if Bool(R(A)) then ip += sBx
+    OP_JUMP_IF_NOT, // A sBx | if not Bool(R(A)) then ip += sBx
     OP_FOR_PREP,    // A sBx | R(A) -= R(A+2) ; ip += sBx
     OP_FOR_LOOP,    // A sBx | R(A) += R(A+2) ; if R(A) < R(A+1)
                     //                          then ip += sBx
@@ -42,17 +46,35 @@ enum OpCode : u8 {
                     //       | if R(A+3) != nil then R(A+2) := R(A+3)
                     //       | else ip++
     OP_CALL,        // A B C | R(A:A+C) := R(A)(R(A+1:A+B+1))
+    OP_TAIL_CALL,   // A B   | return R(A)(R(A+1:A+B+1))
     OP_SELF,        // A B C | R(A+1) := R(B); R(A) := R(B)[RK(C)]
     OP_CLOSURE,     // A Bx  | R(A) := Chunks[Bx]
     OP_CLOSE,       // A     | close R(0:A+1)
     OP_RETURN,      // A B   | return R(A:A+B)
+    OP_CALL_MATH,   // A B C | OP_CALL; R(A) is likely a `math` function
+
+    // Quickened opcodes. These are never emitted by the compiler; rather
+    // `vm_execute()` rewrites the generic opcodes above into these in-place
+    // after observing the operand types, and back again when their guards
+    // fail. They have the exact same operands as their generic versions.
+    OP_ADD_NUM,       // A B C | OP_ADD; RK(B), RK(C) are numbers
+    OP_SUB_NUM,       // A B C | OP_SUB; RK(B), RK(C) are numbers
+    OP_MUL_NUM,       // A B C | OP_MUL; RK(B), RK(C) are numbers
+    OP_DIV_NUM,       // A B C | OP_DIV; RK(B), RK(C) are numbers
+    OP_MOD_NUM,       // A B C | OP_MOD; RK(B), RK(C) are numbers
+    OP_POW_NUM,       // A B C | OP_POW; RK(B), RK(C) are numbers
+    OP_LT_NUM,        // A B C | OP_LT; RK(B), RK(C) are numbers
+    OP_LEQ_NUM,       // A B C | OP_LEQ; RK(B), RK(C) are numbers
+    OP_GET_TABLE_INT, // A B C | OP_GET_TABLE; R(B) is a table, RK(C) a number
+    OP_GET_TABLE_STR, // A B C | OP_GET_TABLE; R(B) is a table, RK(C) a string
+    OP_SET_TABLE_INT, // A B C | OP_SET_TABLE; R(A) is a table, RK(B) a number
 };
 
 // To avoid too much stack usage, we separate calls to `OP_SET_ARRAY` by
 // every nth element.
 #define FIELDS_PER_FLUSH 50
 
-constexpr int OPCODE_COUNT = OP_RETURN + 1;
+constexpr int OPCODE_COUNT = OP_SET_TABLE_INT + 1;
 
 // Fills the `n` lower bits with 1's.
 // Useful when reading bit fields.
@@ -148,6 +170,12 @@ struct Instruction {
         return static_cast<OpCode>(this->extract<OFFSET_OP, MAX_OP>());
     }
 
+    void
+    set_op(OpCode op) noexcept
+    {
+        this->set<OFFSET_OP, MASK0_OP>(static_cast<u32>(op));
+    }
+
     u16
     a() const noexcept
     {
@@ -343,6 +371,13 @@ LULU_DATA const char *const opnames[OPCODE_COUNT];
 LULU_DATA const OpInfo opinfo[OPCODE_COUNT];
 
 
+/** @brief Get the generic opcode which `op` was quickened from, or else `op`
+ *  itself if it was never quickened.
+ */
+OpCode
+opcode_generic(OpCode op);
+
+
 /** @brief Pack an integer into an 8-bit 'floating-point byte'.
  *
  * @details
@@ -1,4 +1,5 @@
-#include <stdio.h> // sprintf
+#include <stdio.h>  // sprintf
+#include <string.h> // strcmp
 
 #include "compiler.hpp"
 #include "debug.hpp"
@@ -250,12 +251,19 @@ expression_list(Parser *p, Compiler *c)
 static void
 return_statement(Parser *p, Compiler *c)
 {
-    u16       ra = c->free_reg;
+    // `return` with no values may use any register. `c->free_reg` may be
+    // past the end of the stack frame, so `R(A)` would be out of bounds.
+    u16       ra = 0;
     Expr_List e{DEFAULT_EXPR, 0};
     if (block_continue(p) && !check(p, TOKEN_SEMI)) {
-        e = expression_list(p, c);
+        ra = c->free_reg;
+        e  = expression_list(p, c);
         if (e.last.has_multret()) {
             compiler_set_returns(c, &e.last, VARARG);
+            // `return f(...)` need not keep our frame around.
+            if (e.count == 1 && e.last.type == EXPR_CALL) {
+                compiler_set_tail_call(c, &e.last);
+            }
             ra      = static_cast<u8>(small_array_len(c->active));
             e.count = VARARG;
         } else {
@@ -441,7 +449,7 @@ condition(Parser *p, Compiler *c)
     if (cond.type == EXPR_NIL) {
         cond.type = EXPR_FALSE;
     }
-    compiler_logical_new(c, &cond, true);
+    compiler_condition(c, &cond);
     return cond.patch_false;
 }
 
@@ -746,6 +754,17 @@ chunk_flatten(lulu_VM *L, Compiler *c, Chunk *p)
     dynamic_shrink(L, &p->children  /*, c->n_children*/);
     slice_resize(L, &p->code, c->pc);
     slice_resize(L, &p->lines, c->n_lines);
+
+    for (Instruction i : p->code) {
+        OpCode op = i.op();
+        if (op == OP_GET_FIELD || op == OP_SET_FIELD
+            || op == OP_GET_GLOBAL || op == OP_SET_GLOBAL)
+        {
+            p->field_cache = slice_make<u32>(L, c->pc);
+            fill(p->field_cache, 0u);
+            break;
+        }
+    }
 }
 
 static void
@@ -1355,6 +1374,8 @@ prefix_expr(Parser *p, Compiler *c)
     case TOKEN_OPEN_PAREN: {
         Expr e = expression(p, c);
         consume_to_close(p, TOKEN_CLOSE_PAREN, TOKEN_OPEN_PAREN, line);
+        // `(f())` is truncated to 1 result, so it is never a tail call.
+        compiler_set_one_return(c, &e);
         return e;
     }
     case TOKEN_OPEN_CURLY:
@@ -1378,6 +1399,33 @@ code_unary : {
     }
 }
 
+/**
+ * @brief
+ *      Is `e` a field of the same name as one of the `math` functions which
+ *      `OP_CALL_MATH` can run inline? We cannot know if it really is that
+ *      function until runtime, so the VM checks again anyway.
+ */
+static bool
+is_math_call(Compiler *c, const Expr &e)
+{
+    static const char *const names[] = {
+        "abs", "ceil", "floor", "max", "min", "sqrt",
+    };
+
+    if (e.type != EXPR_FIELD) {
+        return false;
+    }
+
+    u16         k    = Instruction::reg_get_k(e.table.field_rk);
+    const char *name = c->chunk->constants[k].to_cstring();
+    for (const char *s : names) {
+        if (strcmp(name, s) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static Expr
 primary_expr(Parser *p, Compiler *c)
 {
@@ -1387,11 +1435,16 @@ primary_expr(Parser *p, Compiler *c)
         switch (p->current.type) {
         case TOKEN_OPEN_PAREN:
         case TOKEN_STRING:
-        case TOKEN_OPEN_CURLY:
+        case TOKEN_OPEN_CURLY: {
+            bool is_math = is_math_call(c, e);
             // Function to be called must be on top of the stack.
             compiler_expr_next_reg(c, &e);
             function_call(p, c, &e, line);
+            if (is_math) {
+                get_code(c, e.pc)->set_op(OP_CALL_MATH);
+            }
             break;
+        }
         case TOKEN_DOT:
             // Skip '.'.
             advance(p);
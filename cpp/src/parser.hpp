@@ -52,6 +52,8 @@ enum Expr_Type : u8 {
     EXPR_LOCAL,      // Local variable register stored in `reg`.
     EXPR_INDEXED,    // Table register in `table.reg` and key RK in
                      // `table.field_rk`.
+    EXPR_FIELD,      // Like `EXPR_INDEXED`, but `table.field_rk` is always
+                     // a string constant.
     EXPR_UPVALUE,    // Upvalue index in `upvalue`.
     EXPR_JUMP,       // An `OP_JUMP` chain. Use `pc`.
     EXPR_CALL,       // `OP_CALL`. Use `pc`.
@@ -10,6 +10,7 @@
 using u8  = uint8_t;
 using u16 = uint16_t;
 using u32 = uint32_t;
+using u64 = uint64_t;
 using i8  = int8_t;
 using i32 = int32_t;
 
@@ -83,6 +84,46 @@ number_to_integer(Number n, Integer *i)
     return lulu_Number_eq(static_cast<Number>(*i), n);
 }
 
+/**
+ * @brief
+ *      Numbers whose magnitude is at most this are stored in integer form
+ *      whenever possible. Every integer in this range is exactly
+ *      representable as a `Number`, and adding or subtracting two of them
+ *      never overflows an `Integer`.
+ *
+ * @note(2025-09-14)
+ *      Assumes `Number` is an IEEE-754 double (53-bit significand) and
+ *      `Integer` is at least 64 bits wide.
+ */
+constexpr Integer INTEGER_EXACT_MAX = static_cast<Integer>(1) << 53;
+
+constexpr bool
+integer_is_exact(Integer i)
+{
+    return -INTEGER_EXACT_MAX <= i && i <= INTEGER_EXACT_MAX;
+}
+
+/**
+ * @return
+ *      true if `n` can be stored in integer form without any observable
+ *      difference, else false. Notably `-0` is not, as it is printed with
+ *      its sign.
+ */
+inline bool
+number_to_exact_integer(Number n, Integer *i)
+{
+    // Also rejects NaN, and avoids undefined behavior in the cast.
+    constexpr Number max = static_cast<Number>(INTEGER_EXACT_MAX);
+    if (!(-max <= n && n <= max)) {
+        return false;
+    }
+    *i = static_cast<Integer>(n);
+    if (!lulu_Number_eq(static_cast<Number>(*i), n)) {
+        return false;
+    }
+    return *i != 0 || !signbit(n);
+}
+
 enum Value_Type : u8 {
     VALUE_NIL           = LULU_TYPE_NIL,
     VALUE_BOOLEAN       = LULU_TYPE_BOOLEAN,
@@ -92,6 +133,7 @@ enum Value_Type : u8 {
     VALUE_TABLE         = LULU_TYPE_TABLE,
     VALUE_FUNCTION      = LULU_TYPE_FUNCTION,
     VALUE_USERDATA      = LULU_TYPE_USERDATA,
+    VALUE_THREAD        = LULU_TYPE_THREAD,
 
     // Not accessible from user code.
     VALUE_CHUNK,
@@ -100,7 +142,7 @@ enum Value_Type : u8 {
 };
 
 // 'slice' the Value_Type enum up to the last user-facing type.
-#define VALUE_TYPE_LAST  VALUE_USERDATA
+#define VALUE_TYPE_LAST  VALUE_THREAD
 #define VALUE_TYPE_COUNT (VALUE_INTEGER + 1)
 
 union Object;
@@ -220,6 +262,13 @@ max(T a, T b)
     return (a > b) ? a : b;
 }
 
+template<class T>
+inline T
+min(T a, T b)
+{
+    return (a < b) ? a : b;
+}
+
 template<class T>
 inline void
 swap(T *restrict a, T *restrict b)
@@ -239,6 +239,31 @@ intern_destroy(lulu_VM *L, Intern *t)
     slice_delete(L, t->table);
 }
 
+// Accounts for `s`, which was just chained into `t`.
+static OString *
+intern_count(lulu_VM *L, Intern *t, OString *s)
+{
+#ifdef LULU_DEBUG_LOG_GC
+    object_gc_print(s->to_object(), "[NEW] string");
+#endif // LULU_DEBUG_LOG_GC
+
+    isize n = len(t->table);
+    lulu_assume(n > 0);
+
+    // Count refers to total number of linked list nodes, not occupied array
+    // slots. We probably want to rehash anyway to reduce clustering.
+    if (t->count + 1 > n) {
+        // Prevent new string from being collected immediately.
+        vm_push_value(L, s->to_value());
+
+        // We assume `n` is a power of 2.
+        intern_resize(L, t, n << 1);
+        vm_pop_value(L);
+    }
+    t->count++;
+    return s;
+}
+
 OString *
 ostring_new(lulu_VM *L, LString text)
 {
@@ -262,26 +287,38 @@ ostring_new(lulu_VM *L, LString text)
     s->keyword_type = TOKEN_INVALID;
     s->data[s->len] = 0;
     memcpy(s->data, raw_data(text), static_cast<usize>(len(text)));
+    return intern_count(L, t, s);
+}
 
-#ifdef LULU_DEBUG_LOG_GC
-    object_gc_print(s->to_object(), "[NEW] string");
-#endif // LULU_DEBUG_LOG_GC
-
-    isize n = len(t->table);
-    lulu_assume(n > 0);
-
-    // Count refers to total number of linked list nodes, not occupied array
-    // slots. We probably want to rehash anyway to reduce clustering.
-    if (t->count + 1 > n) {
-        // Prevent new string from being collected immediately.
-        vm_push_value(L, s->to_value());
+OString *
+ostring_alloc(lulu_VM *L, isize n)
+{
+    // Not chained to anything until `ostring_intern()`.
+    Object_List *list = nullptr;
+    OString     *s    = object_new<OString>(L, &list, VALUE_STRING, n);
+    s->len  = n;
+    s->keyword_type = TOKEN_INVALID;
+    s->data[n]      = 0;
+    return s;
+}
 
-        // We assume `n` is a power of 2.
-        intern_resize(L, t, n << 1);
-        vm_pop_value(L);
+OString *
+ostring_intern(lulu_VM *L, OString *s)
+{
+    Intern *t = &G(L)->intern;
+    usize   i = intern_clamp_index(s->hash, len(t->table));
+    for (Object *node = t->table[i]; node != nullptr; node = node->next()) {
+        OString *s2 = &node->ostring;
+        if (s2->hash == s->hash) {
+            if (slice_eq(s->to_lstring(), s2->to_lstring())) {
+                mem_free(L, s, s->len);
+                return s2;
+            }
+        }
     }
-    t->count++;
-    return s;
+    s->next     = t->table[i];
+    t->table[i] = s->to_object();
+    return intern_count(L, t, s);
 }
 
 Userdata *
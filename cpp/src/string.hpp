@@ -166,9 +166,39 @@ constexpr u32 FNV1A_OFFSET = 0x811c9dc5, FNV1A_PRIME = 0x01000193;
 u32
 hash_string(LString text);
 
+/** @brief Copies `text` to `dst` while adding it to `hash`, so that strings
+ *  built in pieces are hashed in the same pass that writes them. */
+inline u32
+hash_string_write(u32 hash, char *dst, LString text)
+{
+    for (char c : text) {
+        *dst++ = c;
+        hash ^= static_cast<u32>(c);
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
 OString *
 ostring_new(lulu_VM *L, LString text);
 
+/** @brief Allocates a string of `n` characters which is not yet interned,
+ *  so that the caller can write its contents in place.
+ *
+ * @note(2025-10-16)
+ *      The result must be passed to `ostring_intern()` afterwards. It is not
+ *      known to the collector until then, so throwing in between leaks it.
+ */
+OString *
+ostring_alloc(lulu_VM *L, isize n);
+
+/** @brief Interns a string from `ostring_alloc()` whose data and hash have
+ *  been filled in. If an equal string already exists, `s` is freed and the
+ *  existing one is returned instead.
+ */
+OString *
+ostring_intern(lulu_VM *L, OString *s);
+
 inline OString *
 ostring_from_cstring(lulu_VM *L, const char *s)
 {
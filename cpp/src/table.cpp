@@ -51,6 +51,7 @@ hash_value(Value v)
     case VALUE_TABLE:
     case VALUE_FUNCTION:
     case VALUE_USERDATA:
+    case VALUE_THREAD:
         return hash_compound(v.to_object());
     case VALUE_INTEGER:
     case VALUE_CHUNK:
@@ -204,10 +205,15 @@ table_array_count(Table *t, Slice<i32> index_ranges)
 static i32
 array_index(Value k)
 {
-    if (k.is_number()) {
+    // Integer form is always exact, so only the range needs checking.
+    if (k.is_integer()) {
+        Integer i = k.to_integer();
+        return (1 <= i && i <= MAX_INDEX) ? static_cast<i32>(i) : -1;
+    } else if (k.is_number()) {
         Integer i = 0;
+        // Don't truncate large integral keys into the valid index range.
         if (number_to_integer(k.to_number(), &i)) {
-            return static_cast<i32>(i);
+            return (1 <= i && i <= MAX_INDEX) ? static_cast<i32>(i) : -1;
         }
     }
     return -1;
@@ -478,6 +484,9 @@ table_is_full(Table *t)
 static Value *
 table_hash_set(lulu_VM *L, Table *t, Value k)
 {
+    // `k` may be the name of a metamethod we cached as absent.
+    table_invalidate_flags(t);
+
     Entry *e = EMPTY_ENTRY;
     // Table still has free slots?
     if (!table_is_full(t)) {
@@ -512,11 +521,15 @@ table_set(lulu_VM *L, Table *t, Value k)
 //=== ARRAY MANIPULATION =============================================== {{{
 
 
-/** @note(2025-09-01) Don't hash lulu_Integer, we want uniform number keys. */
+/** @note(2025-09-01) Don't hash lulu_Integer, we want uniform number keys.
+ *
+ * @note(2025-09-14)
+ *      Integer form is fine, as it hashes and compares as its number value.
+ */
 static Value
 make_integer_key(Integer i)
 {
-    return Value::make_number(static_cast<Number>(i));
+    return Value::make_integral(i);
 }
 
 isize
@@ -575,6 +588,17 @@ table_set_integer(lulu_VM *L, Table *t, Integer i)
     return table_hash_set(L, t, k);
 }
 
+void
+table_reserve_array(lulu_VM *L, Table *t, isize n)
+{
+    if (n <= len(t->array)) {
+        return;
+    }
+    // Keep the hash segment as large as it is.
+    isize n_hash = (raw_data(t->entries) == EMPTY_ENTRY) ? 0 : len(t->entries);
+    table_resize(L, t, n_hash, n);
+}
+
 
 Value
 table_get_string(Table *t, OString *k)
@@ -590,6 +614,16 @@ table_set_string(lulu_VM *L, Table *t, OString *k)
     return table_hash_set(L, t, k2);
 }
 
+isize
+table_find_string(Table *t, OString *k)
+{
+    Entry *e = table_get_entry(t, k->to_value());
+    if (e->key.is_nil()) {
+        return -1;
+    }
+    return ptr_index(t->entries, e);
+}
+
 //=== }}} ==================================================================
 
 // void
@@ -661,7 +695,7 @@ table_next(lulu_VM *L, Table *t, Value *restrict k, Value *restrict v)
     for (/* empty */; i < len(t->array); i++) {
         Value src = t->array[i];
         if (!src.is_nil()) {
-            k->set_number(static_cast<Number>(i + 1));
+            k->set_integer(i + 1);
             *v = src;
             return true;
         }
@@ -16,8 +16,10 @@ struct Entry {
 };
 
 struct Table : Object_Header {
-    // Bit set. 1 indicates metamethod is absent and 0 indicates present.
-    u8 flags;
+    // Bit set, indexed by `Metamethod`, of the metamethods this table is
+    // known to lack when used as a metatable. 1 indicates absent and 0
+    // indicates unknown. Cleared whenever any field is set.
+    u16 flags;
 
     // This object is always independent, so it can be a root during
     // garbage collection.
@@ -61,6 +63,19 @@ table_get(Table *t, Value k, bool *key_exists = nullptr);
 table_set(lulu_VM *L, Table *t, Value k);
 
 
+/** @brief Forgets which metamethods `t` lacks. See `Table::flags`.
+ *
+ * @details
+ *      Call this whenever a field of `t` is written to without going through
+ *      `table_set()` and friends, which already do it.
+ */
+inline void
+table_invalidate_flags(Table *t)
+{
+    t->flags = 0;
+}
+
+
 // Implements `#t`.
 isize
 table_len(Table *t);
@@ -75,6 +90,16 @@ table_len(Table *t);
 table_set_integer(lulu_VM *L, Table *t, Integer i);
 
 
+/** @brief Grows the array segment to at least `n` slots, if it is smaller.
+ *  Integer keys in the hash segment which then fit are moved into it.
+ *
+ * @details
+ *      Used by `OP_SET_ARRAY` so that it can copy straight into `t->array`.
+ */
+void
+table_reserve_array(lulu_VM *L, Table *t, isize n);
+
+
 Value
 table_get_string(Table *t, OString *k);
 
@@ -82,6 +107,16 @@ table_get_string(Table *t, OString *k);
 table_set_string(lulu_VM *L, Table *t, OString *k);
 
 
+/** @brief Find the index of the entry in `t->entries` with key `k`.
+ *
+ * @return
+ *      The index, or -1 if `k` is not in the hash segment. It remains valid
+ *      until the next rehash.
+ */
+isize
+table_find_string(Table *t, OString *k);
+
+
 // void
 // table_unset(Table *t, Value k);
 
@@ -16,6 +16,7 @@ const char *const Value::type_names[VALUE_TYPE_COUNT] = {
     "table",    // VALUE_TABLE
     "function", // VALUE_FUNCTION
     "userdata", // VALUE_USERDATA
+    "thread",   // VALUE_THREAD
 
     "chunk",    // VALUE_CHUNK
     "upvalue",  // VALUE_UPVALUE
@@ -42,6 +43,7 @@ Value::operator==(Value b) const
     case VALUE_TABLE:
     case VALUE_FUNCTION:
     case VALUE_USERDATA:
+    case VALUE_THREAD:
         return this->to_object() == b.to_object();
     case VALUE_INTEGER:
     case VALUE_CHUNK:
@@ -78,10 +80,16 @@ print_pointer:
     case VALUE_TABLE:
     case VALUE_FUNCTION:
     case VALUE_USERDATA:
+    case VALUE_THREAD:
         goto print_pointer;
-    case VALUE_INTEGER:
+    // Registers are no longer cleared on every call, so those not yet written
+    // to may still hold e.g. the chunk that the parser left there.
     case VALUE_CHUNK:
     case VALUE_UPVALUE:
+        fprintf(stdout, "%s: %p", v.type_name(),
+            static_cast<void *>(v.to_object()));
+        break;
+    case VALUE_INTEGER:
         lulu_panicf("Value_Type(%i) should not reach here", t);
         break;
     }
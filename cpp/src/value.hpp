@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string.h> // memcpy
+
 #include "private.hpp"
 #include "slice.hpp" // LString
 
@@ -12,8 +14,59 @@ struct Chunk;
 
 struct Value {
 private:
-    // Later on, if we decide to incorporate NaN-boxing/Pointer-tagging, we can
-    // use macros to change what members are to be included in the struct.
+#if LULU_NAN_BOXING
+    /**
+     * @brief
+     *      Numbers are stored as-is. Everything else is stored as a negative
+     *      quiet NaN, with the `Value_Type` and payload in the mantissa:
+     *
+     *      1 11111111111 1 tttt pppppppp...pppppppp
+     *      ^ sign        ^ quiet bit
+     *        ^ exponent    ^ type  ^ 47-bit payload
+     *
+     * @note(2025-09-15)
+     *      Hardware may produce the exact same bit pattern as a boxed `nil`
+     *      (e.g. `0/0` on x86), so `make_number()` replaces negative quiet
+     *      NaNs with `NANBOX_NAN`. It is a negative signaling NaN, so it
+     *      still compares and prints the same.
+     */
+    static constexpr u64 NANBOX_TAG        = 0xfff8'0000'0000'0000;
+    static constexpr u64 NANBOX_NAN        = 0xfff0'0000'0000'0001;
+    static constexpr int NANBOX_TYPE_SHIFT = 47;
+    static constexpr u64 NANBOX_PAYLOAD =
+        (static_cast<u64>(1) << NANBOX_TYPE_SHIFT) - 1;
+
+    static constexpr u64
+    nanbox_tag(Value_Type t) noexcept
+    {
+        return NANBOX_TAG | (static_cast<u64>(t) << NANBOX_TYPE_SHIFT);
+    }
+
+    u64 m_bits = nanbox_tag(VALUE_NIL);
+
+    static constexpr Value
+    make_boxed(Value_Type t, u64 payload)
+    {
+        Value v{};
+        v.m_bits = nanbox_tag(t) | (payload & NANBOX_PAYLOAD);
+        return v;
+    }
+
+    static Value
+    make_pointer(void *p, Value_Type t)
+    {
+        u64 payload = static_cast<u64>(reinterpret_cast<uintptr_t>(p));
+        lulu_assert((payload & ~NANBOX_PAYLOAD) == 0);
+        return make_boxed(t, payload);
+    }
+
+    void *
+    payload_pointer() const noexcept
+    {
+        uintptr_t p = static_cast<uintptr_t>(this->m_bits & NANBOX_PAYLOAD);
+        return reinterpret_cast<void *>(p);
+    }
+#else /* ^^^ LULU_NAN_BOXING, vvv otherwise */
     Value_Type m_type = VALUE_NIL;
     union {
         Integer m_integer = 0;
@@ -22,45 +75,112 @@ private:
         Object *m_object;
         void   *m_pointer; // light userdata.
     };
+#endif /* LULU_NAN_BOXING */
+
+    /** @brief The type tag as stored, i.e. integers are `VALUE_INTEGER`. */
+    constexpr Value_Type
+    raw_type() const noexcept
+    {
+#if LULU_NAN_BOXING
+        if ((this->m_bits & NANBOX_TAG) != NANBOX_TAG) {
+            return VALUE_NUMBER;
+        }
+        u64 t = (this->m_bits >> NANBOX_TYPE_SHIFT) & 0xf;
+        return static_cast<Value_Type>(t);
+#else
+        return this->m_type;
+#endif
+    }
+
+    /** @brief `t` must not be `VALUE_NUMBER`, as it has no single tag. */
+    constexpr bool
+    is_raw(Value_Type t) const noexcept
+    {
+#if LULU_NAN_BOXING
+        return (this->m_bits >> NANBOX_TYPE_SHIFT)
+            == (nanbox_tag(t) >> NANBOX_TYPE_SHIFT);
+#else
+        return this->m_type == t;
+#endif
+    }
 
 public:
     static constexpr Value
     make_boolean(bool b)
     {
+#if LULU_NAN_BOXING
+        return make_boxed(VALUE_BOOLEAN, static_cast<u64>(b));
+#else
         Value v{};
         v.m_type    = VALUE_BOOLEAN;
         v.m_boolean = b;
         return v;
+#endif
     }
 
     // @note 2025-07-21 Affected by Nan-boxing/Pointer-tagging
-    static constexpr Value
+    static Value
     make_number(Number n)
     {
         Value v{};
+#if LULU_NAN_BOXING
+        memcpy(&v.m_bits, &n, sizeof(v.m_bits));
+        if ((v.m_bits & NANBOX_TAG) == NANBOX_TAG) {
+            v.m_bits = NANBOX_NAN;
+        }
+#else
         v.m_type   = VALUE_NUMBER;
         v.m_number = n;
+#endif
         return v;
     }
 
-    /** @brief Internal use only. Helps store integers without `lulu_Number`.
+    /** @brief Stores `i` in integer form, which is a number as far as user
+     *  code is concerned. See `number_to_exact_integer()`.
+     *
+     * @note(2025-09-14)
+     *      If `i` may be used as a number, it must satisfy
+     *      `integer_is_exact()`. Otherwise, use `make_integral()`.
+     *
+     * @note(2025-09-15)
+     *      With `LULU_NAN_BOXING` there is no integer form, as numbers are
+     *      already stored unboxed and untagging/retagging integers only
+     *      slows down arithmetic. So `i` is simply stored as a number.
      */
-    static constexpr Value
+    static Value
     make_integer(Integer i)
     {
+#if LULU_NAN_BOXING
+        return make_number(static_cast<Number>(i));
+#else
         Value v{};
         v.m_type    = VALUE_INTEGER;
         v.m_integer = i;
         return v;
+#endif
+    }
+
+    /** @brief A number with the value of `i`, in integer form if possible. */
+    static Value
+    make_integral(Integer i)
+    {
+        if (integer_is_exact(i)) {
+            return make_integer(i);
+        }
+        return make_number(static_cast<Number>(i));
     }
 
     static Value
     make_object(Object *o, Value_Type t)
     {
+#if LULU_NAN_BOXING
+        return make_pointer(o, t);
+#else
         Value v;
         v.m_type   = t;
         v.m_object = o;
         return v;
+#endif
     }
 
     static Value
@@ -81,13 +201,23 @@ public:
         return make_object(reinterpret_cast<Object *>(f), VALUE_FUNCTION);
     }
 
+    static Value
+    make_thread(lulu_VM *L)
+    {
+        return make_object(reinterpret_cast<Object *>(L), VALUE_THREAD);
+    }
+
     static Value
     make_lightuserdata(void *p)
     {
+#if LULU_NAN_BOXING
+        return make_pointer(p, VALUE_LIGHTUSERDATA);
+#else
         Value v;
         v.m_type    = VALUE_LIGHTUSERDATA;
         v.m_pointer = p;
         return v;
+#endif
     }
 
     void
@@ -108,6 +238,12 @@ public:
         *this = this->make_integer(i);
     }
 
+    void
+    set_integral(Integer i) noexcept
+    {
+        *this = this->make_integral(i);
+    }
+
     void
     set_string(OString *os) noexcept
     {
@@ -126,6 +262,12 @@ public:
         *this = this->make_function(f);
     }
 
+    void
+    set_thread(lulu_VM *L) noexcept
+    {
+        *this = this->make_thread(L);
+    }
+
     void
     set_lightuserdata(void *p) noexcept
     {
@@ -147,71 +289,98 @@ public:
         return Value::type_names[t];
     }
 
-    // @note 2025-07-19 Affected by Nan-boxing/Pointer-tagging
+    /** @note(2025-07-19) Affected by Nan-boxing/Pointer-tagging
+     *
+     * @note(2025-09-14)
+     *      Integers are reported as `VALUE_NUMBER`, as they are merely an
+     *      alternate representation. Use `is_integer()` to tell them apart.
+     */
     constexpr Value_Type
     type() const noexcept
     {
-        return this->m_type;
+        Value_Type t = this->raw_type();
+        return (t == VALUE_INTEGER) ? VALUE_NUMBER : t;
     }
 
     constexpr bool
     is_nil() const noexcept
     {
-        return this->type() == VALUE_NIL;
+        return this->is_raw(VALUE_NIL);
     }
 
     constexpr bool
     is_boolean() const noexcept
     {
-        return this->type() == VALUE_BOOLEAN;
+        return this->is_raw(VALUE_BOOLEAN);
     }
 
     constexpr bool
     is_number() const noexcept
     {
+#if LULU_NAN_BOXING
+        return (this->m_bits & NANBOX_TAG) != NANBOX_TAG;
+#else
         return this->type() == VALUE_NUMBER;
+#endif
     }
 
     constexpr bool
     is_integer() const noexcept
     {
-        return this->type() == VALUE_INTEGER;
+#if LULU_NAN_BOXING
+        return false;
+#else
+        return this->m_type == VALUE_INTEGER;
+#endif
     }
 
     constexpr bool
     is_lightuserdata() const noexcept
     {
-        return this->type() == VALUE_LIGHTUSERDATA;
+        return this->is_raw(VALUE_LIGHTUSERDATA);
     }
 
     constexpr bool
     is_object() const noexcept
     {
+#if LULU_NAN_BOXING
+        // Numbers never have the top bits of a boxed value (`make_number()`).
+        u64 t = (this->m_bits >> NANBOX_TYPE_SHIFT)
+            - (nanbox_tag(VALUE_STRING) >> NANBOX_TYPE_SHIFT);
+        return t <= static_cast<u64>(VALUE_UPVALUE - VALUE_STRING);
+#else
         return VALUE_STRING <= this->type() && this->type() <= VALUE_UPVALUE;
+#endif
     }
 
     constexpr bool
     is_string() const noexcept
     {
-        return this->type() == VALUE_STRING;
+        return this->is_raw(VALUE_STRING);
     }
 
     constexpr bool
     is_table() const noexcept
     {
-        return this->type() == VALUE_TABLE;
+        return this->is_raw(VALUE_TABLE);
     }
 
     constexpr bool
     is_function() const noexcept
     {
-        return this->type() == VALUE_FUNCTION;
+        return this->is_raw(VALUE_FUNCTION);
     }
 
     constexpr bool
     is_userdata() const noexcept
     {
-        return this->type() == VALUE_USERDATA;
+        return this->is_raw(VALUE_USERDATA);
+    }
+
+    constexpr bool
+    is_thread() const noexcept
+    {
+        return this->is_raw(VALUE_THREAD);
     }
 
     //=== }}} =================================================================
@@ -223,7 +392,11 @@ public:
     to_boolean() const
     {
         lulu_assert(this->is_boolean());
+#if LULU_NAN_BOXING
+        return (this->m_bits & NANBOX_PAYLOAD) != 0;
+#else
         return this->m_boolean;
+#endif
     }
 
     // @note 2025-07-19 Affected by Nan-boxing/Pointer-tagging
@@ -231,7 +404,16 @@ public:
     to_number() const
     {
         lulu_assert(this->is_number());
+        if (this->is_integer()) {
+            return static_cast<Number>(this->to_integer());
+        }
+#if LULU_NAN_BOXING
+        Number n;
+        memcpy(&n, &this->m_bits, sizeof(n));
+        return n;
+#else
         return this->m_number;
+#endif
     }
 
     /** @note(2025-07-19) Affected by Nan-boxing/pointer-tagging. */
@@ -239,7 +421,11 @@ public:
     to_integer() const
     {
         lulu_assert(this->is_integer());
+#if LULU_NAN_BOXING
+        return static_cast<Integer>(this->to_number());
+#else
         return this->m_integer;
+#endif
     }
 
     // @note 2025-07-19 Affected by Nan-boxing/Pointer-tagging
@@ -247,14 +433,22 @@ public:
     to_lightuserdata() const
     {
         lulu_assert(this->is_lightuserdata());
+#if LULU_NAN_BOXING
+        return this->payload_pointer();
+#else
         return this->m_pointer;
+#endif
     }
 
     // @note 2025-07-19 Affected by Nan-boxing/Pointer-tagging
     Object *
     to_object() const noexcept
     {
+#if LULU_NAN_BOXING
+        return static_cast<Object *>(this->payload_pointer());
+#else
         return this->m_object;
+#endif
     }
 
     //=== }}} ==================================================================
@@ -283,10 +477,18 @@ public:
     inline Userdata *
     to_userdata() const;
 
+    // Defined in vm.hpp, as threads are simply `lulu_VM` instances.
+    inline lulu_VM *
+    to_thread() const;
+
     inline void *
     to_pointer() const;
 };
 
+#if LULU_NAN_BOXING
+static_assert(sizeof(Value) == 8, "NaN-boxed Value must fit in 8 bytes");
+#endif /* LULU_NAN_BOXING */
+
 Value
 Object_Header::to_value()
 {
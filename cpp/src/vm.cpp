@@ -2,7 +2,9 @@
 #include <stdlib.h> // abort
 #include <string.h> // strchr
 
+#include "aot.hpp"
 #include "debug.hpp"
+#include "jit.hpp"
 #include "parser.hpp"
 #include "vm.hpp"
 #include "metamethod.hpp"
@@ -15,12 +17,21 @@ overflow_error(lulu_VM *L, isize n, isize limit, const char *what)
     vm_runtime_error(L, "C stack overflow (%s %s used)", buf, what);
 }
 
+static void
+stack_resize(lulu_VM *L, isize n);
+
+static void
+frame_reserve(lulu_VM *L, isize n);
+
 static void
 required_allocations(lulu_VM *L, void *)
 {
     lulu_Global *g = G(L);
     Table *t;
 
+    stack_resize(L, STACK_SIZE_INIT);
+    frame_reserve(L, 8);
+
     t = table_new(L, /*n_hash=*/8, /*n_array=*/0);
     g->registry.set_table(t);
 
@@ -56,9 +67,14 @@ lulu_open(lulu_Allocator allocator, void *allocator_data)
     *g = {};
     g->allocator = allocator;
     g->allocator_data = allocator_data;
+    g->max_calls = LULU_MAX_CALLS;
+    g->jit_enabled = LULU_JIT;
     // VM state
     *L = {};
     L->G = g;
+    L->type = VALUE_THREAD;
+    L->set_fixed();
+    g->main_thread = L;
     // @note(2025-08-30) Point to stack already so length updates are valid.
     L->window = slice(L->stack, 0, 0);
 
@@ -81,6 +97,9 @@ lulu_close(lulu_VM *L)
     lulu_Global *g = G(L);
     builder_destroy(L, &g->builder);
     intern_destroy(L, &g->intern);
+    slice_delete(L, L->stack);
+    slice_delete(L, L->open_slots);
+    dynamic_delete(L, L->frames);
 
     // Free ALL objects unconditionally since the VM is about to be freed.
     Object *o = g->objects;
@@ -90,6 +109,50 @@ lulu_close(lulu_VM *L)
         object_free(L, o);
         o = next;
     }
+#if LULU_AOT
+    // Only now is nothing left that may point to their code.
+    aot_close(L);
+#endif // LULU_AOT
+}
+
+LULU_API int
+lulu_set_call_limit(lulu_VM *L, int limit)
+{
+    lulu_Global *g    = G(L);
+    int          prev = g->max_calls;
+
+    // Need at least 1 frame to be able to call anything at all.
+    g->max_calls = max(limit, 1);
+
+    // `frame_push()` relies on the capacity never exceeding the limit.
+    if (cap(L->frames) > g->max_calls) {
+        isize n = static_cast<isize>(g->max_calls);
+        frame_reserve(L, max(len(L->frames), n));
+    }
+    return prev;
+}
+
+LULU_API int
+lulu_set_jit(lulu_VM *L, int enable)
+{
+    lulu_Global *g    = G(L);
+    bool         prev = g->jit_enabled;
+    g->jit_enabled = LULU_JIT && enable;
+    return prev;
+}
+
+LULU_API int
+lulu_set_budget(lulu_VM *L, int budget, lulu_Budget_Handler handler,
+    void *handler_data)
+{
+    lulu_Global *g    = G(L);
+    int          prev = (g->has_budget) ? max(g->budget_left, 0) : -1;
+
+    g->has_budget     = budget > 0;
+    g->budget_left    = max(budget, 0);
+    g->budget_handler = handler;
+    g->budget_data    = handler_data;
+    return prev;
 }
 
 //=== CALL FRAME ARRAY MANIPULATION ==================================== {{{
@@ -97,19 +160,20 @@ lulu_close(lulu_VM *L)
 static Call_Frame *
 frame_get(lulu_VM *L, isize i)
 {
-    return small_array_get_ptr(&L->frames, i);
+    return &L->frames[i];
 }
 
 static void
 frame_resize(lulu_VM *L, isize i)
 {
-    small_array_resize(&L->frames, i);
+    lulu_assert(0 <= i && i <= cap(L->frames));
+    L->frames.len = i;
 }
 
 static Slice<Call_Frame>
 frame_slice(lulu_VM *L)
 {
-    return small_array_slice(L->frames);
+    return slice(L->frames);
 }
 
 // Get the absolute index of `cf` in the `L->frames` array.
@@ -122,21 +186,55 @@ frame_index(lulu_VM *L, Call_Frame *cf)
     return ptr_index(frame_slice(L), cf);
 }
 
+/** @brief Reallocates the call frame array to hold `n` frames, keeping
+ *  `L->caller` pointing to the same frame.
+ *
+ * @note(2025-09-17)
+ *      Frames are otherwise only ever referred to by index across calls.
+ */
+static void
+frame_reserve(lulu_VM *L, isize n)
+{
+    int caller = frame_index(L, L->caller);
+    dynamic_reserve(L, &L->frames, n);
+    if (L->caller != nullptr) {
+        L->caller = frame_get(L, caller);
+    }
+}
+
+/** @brief Grows the call frame array, if still under the call limit. Its
+ *  capacity never exceeds the limit, so that `frame_push()` only needs to
+ *  check the capacity.
+ */
+[[gnu::noinline]] static void
+frame_grow(lulu_VM *L, isize n)
+{
+    int limit = G(L)->max_calls;
+    if (n >= limit) {
+        overflow_error(L, n, limit, "call frames");
+    }
+    isize next = mem_next_fib(max(n + 1, 8_i));
+    frame_reserve(L, min(next, static_cast<isize>(limit)));
+}
+
 static void
 frame_push(lulu_VM *L, Closure *fn, Slice<Value> window, int to_return)
 {
-    isize n = small_array_len(L->frames);
-    if (n >= small_array_cap(L->frames)) {
-        overflow_error(L, n, small_array_cap(L->frames), "call frames");
+    isize n = len(L->frames);
+    if (n >= cap(L->frames)) {
+        frame_grow(L, n);
     }
-    small_array_resize(&L->frames, n + 1);
+    L->frames.len = n + 1;
 
     // Caller state
     Call_Frame *cf = frame_get(L, n);
-    cf->function   = fn;
-    cf->window     = window;
-    cf->saved_ip   = nullptr;
-    cf->to_return  = to_return;
+    cf->function     = fn;
+    cf->window       = window;
+    cf->saved_ip     = nullptr;
+    cf->to_return    = to_return;
+    cf->is_tail_call = false;
+
+    cf->is_continuation = false;
 
     // VM state
     L->caller = cf;
@@ -147,9 +245,9 @@ static Call_Frame *
 frame_pop(lulu_VM *L)
 {
     // Have a previous frame to return to?
-    small_array_pop(&L->frames);
+    dynamic_pop(&L->frames);
     Call_Frame *frame = nullptr;
-    isize       i     = small_array_len(L->frames);
+    isize       i     = len(L->frames);
     if (i > 0) {
         frame      = frame_get(L, i - 1);
         L->window = frame->window;
@@ -177,6 +275,11 @@ get_error_object(lulu_VM *L, Error e)
     case LULU_ERROR_MEMORY:
         return ostring_new(L, lstring_literal(LULU_MEMORY_ERROR_STRING));
     case LULU_ERROR_RUNTIME:
+        if (L->lazy_error) {
+            L->lazy_error = false;
+            return ostring_new(L, builder_to_string(G(L)->builder));
+        }
+        [[fallthrough]];
     case LULU_ERROR_SYNTAX:
         return L->window[len(L->window) - 1].to_ostring();
     default:
@@ -206,11 +309,13 @@ vm_pcall(lulu_VM *L, Protected_Fn fn, void *user_ptr)
 {
     int old_base = vm_save_base(L);
     int old_top  = vm_save_top(L);
-    // Don't use pointers because in the future, `frames` may be dynamic.
-    int old_cf = frame_index(L, L->caller);
+    // Don't use pointers because `frames` may be reallocated.
+    int old_cf     = frame_index(L, L->caller);
+    int old_ccalls = L->n_ccalls;
 
     Error e = vm_run_protected(L, fn, user_ptr);
     if (e != LULU_OK) {
+        L->n_ccalls = old_ccalls;
         set_error_object(L, e, old_cf, old_base, old_top);
     }
     return e;
@@ -219,14 +324,23 @@ vm_pcall(lulu_VM *L, Protected_Fn fn, void *user_ptr)
 Error
 vm_run_protected(lulu_VM *L, Protected_Fn fn, void *user_ptr)
 {
-    Error_Handler next{L->error_handler, LULU_OK};
+    Error_Handler next;
+    next.prev  = L->error_handler;
+    next.error = LULU_OK;
     // Chain new handler
     L->error_handler = &next;
+#if LULU_USE_LONGJMP
+    // `vm_throw()` sets `next.error` itself.
+    if (setjmp(next.jump) == 0) {
+        fn(L, user_ptr);
+    }
+#else // ^^^ LULU_USE_LONGJMP, vvv otherwise
     try {
         fn(L, user_ptr);
     } catch (Error e) {
         next.error = e;
     }
+#endif // LULU_USE_LONGJMP
 
     // Restore old handler
     L->error_handler = next.prev;
@@ -237,8 +351,15 @@ void
 vm_throw(lulu_VM *L, Error e)
 {
     lulu_Global *g = G(L);
+    // The instruction which allowed it, if any, is abandoned.
+    L->can_continue = false;
     if (L->error_handler != nullptr) {
+#if LULU_USE_LONGJMP
+        L->error_handler->error = e;
+        longjmp(L->error_handler->jump, 1);
+#else // ^^^ LULU_USE_LONGJMP, vvv otherwise
         throw e;
+#endif // LULU_USE_LONGJMP
     } else if (g->panic_fn != nullptr) {
         set_error_object(L, e, /*old_cf=*/0, /*old_base=*/0, /*old_top=*/0);
         L->error_handler = nullptr;
@@ -250,9 +371,9 @@ vm_throw(lulu_VM *L, Error e)
 bool
 vm_to_number(const Value *v, Value *out)
 {
-    // Nothing to do?
+    // Nothing to do? Keep integer form, if any.
     if (v->is_number()) {
-        out->set_number(v->to_number());
+        *out = *v;
         return true;
     }
     // Try to parse the string.
@@ -304,10 +425,9 @@ vm_push_fstring(lulu_VM *L, const char *fmt, ...)
     return msg;
 }
 
-const char *
-vm_push_vfstring(lulu_VM *L, const char *fmt, va_list args)
+static void
+write_vfstring(lulu_VM *L, Builder *b, const char *fmt, va_list args)
 {
-    Builder    *b      = vm_get_builder(L);
     const char *cursor = fmt;
 
     for (;;) {
@@ -351,29 +471,40 @@ vm_push_vfstring(lulu_VM *L, const char *fmt, va_list args)
         // Point to format string after this format specifier sequence.
         cursor = arg + 2;
     }
+}
+
+const char *
+vm_push_vfstring(lulu_VM *L, const char *fmt, va_list args)
+{
+    Builder *b = vm_get_builder(L);
+    write_vfstring(L, b, fmt, args);
     return vm_push_string(L, builder_to_string(*b));
 }
 
 void
 vm_runtime_error(lulu_VM *L, const char *fmt, ...)
 {
+    Builder    *b  = vm_get_builder(L);
     Call_Frame *cf = L->caller;
     if (cf->is_lua()) {
         const Chunk *p    = cf->to_lua()->chunk;
         int          pc   = ptr_index(p->code, L->saved_ip) - 1;
         int          line = chunk_line_get(p, pc);
-        vm_push_fstring(L, "%s:%i: ", p->source->to_cstring(), line);
+        builder_write_lstring(L, b, p->source->to_lstring());
+        builder_write_char(L, b, ':');
+        builder_write_int(L, b, line);
+        builder_write_lstring(L, b, ": "_s);
     } else {
-        vm_push_string(L, "[C]: "_s);
+        builder_write_lstring(L, b, "[C]: "_s);
     }
 
     va_list args;
     va_start(args, fmt);
-    vm_push_vfstring(L, fmt, args);
+    write_vfstring(L, b, fmt, args);
     va_end(args);
 
-    lulu_concat(L, 2);
-
+    // Nothing else may use the builder until the error is caught.
+    L->lazy_error = true;
     vm_throw(L, LULU_ERROR_RUNTIME);
 }
 
@@ -399,6 +530,9 @@ load(lulu_VM *L, void *user_ptr)
     vm_push_value(L, source->to_value());
     Chunk   *p = parser_program(L, source, d->stream, &d->builder);
     Closure *f = closure_lua_new(L, p);
+#if LULU_AOT
+    aot_bind(L, p);
+#endif // LULU_AOT
 
     vm_pop_value(L); // constants table
     vm_pop_value(L); // chunk
@@ -415,12 +549,102 @@ vm_load(lulu_VM *L, LString source, Stream *z)
     return e;
 }
 
+static Value *
+stack_rebase(Value *p, const Value *old_data, Value *new_data)
+{
+    return new_data + (p - old_data);
+}
+
+/** @brief Reallocates the stack to exactly `n` slots, then fixes up every
+ *  pointer into it that outlives the current call.
+ *
+ * @note(2025-09-17)
+ *      Analogous to `ldo.c:luaD_reallocstack()` and `ldo.c:correctstack()` in
+ *      Lua 5.1.5. Saved instruction pointers point into chunks rather than
+ *      the stack, so they need no fixing up.
+ */
+static void
+stack_resize(lulu_VM *L, isize n)
+{
+    Value *old_data = raw_data(L->stack);
+    isize  old_len  = len(L->stack);
+
+    // Slots past the top never have open upvalues, so `open_slots` may only
+    // ever be longer than the stack. Grow it first and shrink it last.
+    if (n > len(L->open_slots)) {
+        isize old_slots = len(L->open_slots);
+        slice_resize(L, &L->open_slots, n);
+        fill(slice_from(L->open_slots, old_slots),
+            static_cast<Upvalue *>(nullptr));
+    }
+    slice_resize(L, &L->stack, n);
+    if (n < len(L->open_slots)) {
+        slice_resize(L, &L->open_slots, n);
+    }
+
+    Value *data = raw_data(L->stack);
+    if (n > old_len) {
+        fill(slice_from(L->stack, old_len), nil);
+    }
+
+    L->window.data = stack_rebase(L->window.data, old_data, data);
+    for (Call_Frame &cf : frame_slice(L)) {
+        cf.window.data = stack_rebase(cf.window.data, old_data, data);
+    }
+    for (Object *o = L->open_upvalues; o != nullptr; o = o->next()) {
+        Upvalue *up = &o->upvalue;
+        up->value   = stack_rebase(up->value, old_data, data);
+    }
+}
+
 void
 vm_check_stack(lulu_VM *L, int n)
 {
     int stop = vm_save_top(L) + n;
-    if (stop >= count_of(L->stack)) {
-        overflow_error(L, stop, count_of(L->stack), "stack slots");
+    if (stop + STACK_EXTRA <= len(L->stack)) {
+        return;
+    }
+
+    if (stop > MAX_STACK) {
+        overflow_error(L, stop, MAX_STACK, "stack slots");
+    }
+
+    isize next = len(L->stack);
+    while (next < stop + STACK_EXTRA) {
+        next *= 2;
+    }
+    if (next > MAX_STACK + STACK_EXTRA) {
+        next = MAX_STACK + STACK_EXTRA;
+    }
+    stack_resize(L, next);
+}
+
+/** @brief Gives back most of the stack after a spike in usage, e.g. from deep
+ *  recursion. At most a quarter of the result is in use, so that recursion
+ *  hovering around some depth does not keep reallocating it.
+ *
+ * @note(2025-09-17)
+ *      Lua 5.1.5 does this in `lgc.c:checkstacksizes()`. However our GC may
+ *      run while other stack pointers are still held, so this is only done
+ *      after returning from a call.
+ */
+static void
+stack_shrink(lulu_VM *L)
+{
+    // Frames may extend past the current top, e.g. when a caller uses more
+    // registers than its callee does.
+    int top = vm_save_top(L);
+    for (Call_Frame &cf : frame_slice(L)) {
+        top = max(top, ptr_index(L->stack, end(cf.window)));
+    }
+
+    isize n    = len(L->stack);
+    isize next = n;
+    while (next / 2 >= STACK_SIZE_INIT && next / 8 >= top + STACK_EXTRA) {
+        next /= 2;
+    }
+    if (next < n) {
+        stack_resize(L, next);
     }
 }
 
@@ -451,10 +675,17 @@ vm_call(lulu_VM *L, const Value *ra, int n_args, int n_rets)
         cf->window = L->window;
     }
 
+    if (L->n_ccalls >= LULU_MAX_CCALLS) {
+        overflow_error(L, L->n_ccalls, LULU_MAX_CCALLS, "C calls");
+    }
+    L->n_ccalls++;
     Call_Type t = vm_call_init(L, ra, n_args, n_rets);
     if (t == CALL_LUA) {
         vm_execute(L, 1);
     }
+    // Yielding across us is disallowed by `lulu_yield()`.
+    lulu_assert(t != CALL_YIELD);
+    L->n_ccalls--;
 }
 
 static Call_Type
@@ -473,7 +704,13 @@ call_init_c(lulu_VM *L, Closure *f, int f_index, int n_args, int n_rets)
     Slice<Value> window = slice(L->stack, base, top);
     frame_push(L, f, window, n_rets);
 
-    n_rets           = f->to_c()->callback(L);
+    n_rets = f->to_c()->callback(L);
+    // Frame is finished by `lulu_resume()` instead.
+    if (n_rets < 0) {
+        lulu_assert(L->status == LULU_YIELD);
+        return CALL_YIELD;
+    }
+
     Value *first_ret;
     if (n_rets > 0) {
         first_ret = &L->window[len(L->window) - n_rets];
@@ -484,6 +721,41 @@ call_init_c(lulu_VM *L, Closure *f, int f_index, int n_args, int n_rets)
     return CALL_C;
 }
 
+/**
+ * @brief
+ *      Calls the light C function `*ra` from `OP_CALL`. See
+ *      `lulu_push_light_function()`. It never calls back into Lua nor yields,
+ *      so its frame need not be set up to be resumed or re-entered: unlike
+ *      `call_init_c()` and `vm_call_fini()`, its results are moved straight
+ *      to `ra` and the caller's frame is restored as it was.
+ *
+ * @param n_rets
+ *      Must not be `VARARG`.
+ */
+static void
+call_light(lulu_VM *L, const Value *ra, int n_args, int n_rets)
+{
+    Closure *f        = ra->to_function();
+    int      ra_index = vm_save_index(L, ra);
+    int      base     = ra_index + 1;
+    int      top      = (n_args == VARARG) ? vm_save_top(L) : base + n_args;
+
+    // May reallocate the stack, so `ra` is no longer used after this.
+    vm_check_stack(L, LULU_STACK_MIN);
+    L->caller->saved_ip = L->saved_ip;
+    frame_push(L, f, slice(L->stack, base, top), n_rets);
+
+    int n = f->to_c()->callback(L);
+    lulu_assert(n >= 0);
+
+    const Value *results = vm_ptr_top(L) - n;
+    Value       *dst     = &L->stack[ra_index];
+    for (int i = 0; i < n_rets; i++) {
+        dst[i] = (i < n) ? results[i] : nil;
+    }
+    frame_pop(L);
+}
+
 static Call_Type
 call_init_lua(lulu_VM *L, Closure *fn, int fn_index, int n_args, int n_rets)
 {
@@ -491,27 +763,30 @@ call_init_lua(lulu_VM *L, Closure *fn, int fn_index, int n_args, int n_rets)
     int    base = fn_index + 1;
     Chunk *p    = fn->to_lua()->chunk;
     int    top  = base + p->stack_used;
+    if (n_args == VARARG) {
+        // Arguments end at the last result of the variadic call.
+        n_args = vm_save_top(L) - base;
+    }
 
     vm_check_stack(L, top - base);
     Slice<Value> window = slice(L->stack, base, top);
 
-    // Some parameters weren't provided so they need to be initialized to nil?
-    int extra = p->n_params;
-    if (n_args == VARARG) {
-        extra -= len(window);
-    } else {
-        extra -= n_args;
+    // Missing parameters, and locals which the compiler assumes start out as
+    // `nil`, are cleared. Every other register is written to before it is
+    // read, so it may keep whatever was there before. That is always a
+    // live value or `nil`, as `gc_mark_thread()` clears what it does not
+    // mark.
+    int start_nil = base + min(n_args, static_cast<int>(p->n_params));
+    int stop_nil  = base + max(p->n_params, p->stack_cleared);
+    if (start_nil < stop_nil) {
+        fill(slice(L->stack, start_nil, stop_nil), nil);
     }
 
-    int start_nil = base + p->n_params;
-    if (extra > 0) {
-        start_nil -= extra;
-    }
-    fill(slice(L->stack, start_nil, top), nil);
+    // May throw, so the caller's `saved_ip` must still be intact.
+    frame_push(L, fn, window, n_rets);
 
     // We will goto `re_entry` in `vm_execute()`.
     L->saved_ip = raw_data(p->code);
-    frame_push(L, fn, window, n_rets);
     return CALL_LUA;
 }
 
@@ -538,6 +813,35 @@ vm_call_init(lulu_VM *L, const Value *ra, int n_args, int n_rets)
     return call_init_lua(L, fn, fn_index, n_args, n_rets);
 }
 
+/**
+ * @note(2025-09-16)
+ *      Analogous to the `OP_TAILCALL` case of `lvm.c:luaV_execute()` in
+ *      Lua 5.1.5.
+ */
+void
+vm_call_tail(lulu_VM *L, const Value *ra, int n_args)
+{
+    lulu_assert(L->caller->is_lua() && ra->to_function()->is_lua());
+    if (n_args == VARARG) {
+        // Arguments end at the last result of the variadic call.
+        n_args = static_cast<int>(vm_ptr_top(L) - (ra + 1));
+    }
+
+    // Overwrite our own function object and everything after it.
+    Value       *dst = vm_ptr_base(L) - 1;
+    Slice<Value> args{dst, n_args + 1};
+    copy(args, slice_pointer_len(ra, n_args + 1));
+
+    // Reuse our frame slot; results go directly to our own caller.
+    int  n_rets          = L->caller->to_return;
+    bool is_continuation = L->caller->is_continuation;
+    dynamic_pop(&L->frames);
+    call_init_lua(L, dst->to_function(), vm_save_index(L, dst), n_args,
+        n_rets);
+    L->caller->is_tail_call    = true;
+    L->caller->is_continuation = is_continuation;
+}
+
 void
 vm_call_fini(lulu_VM *L, Slice<Value> results)
 {
@@ -563,24 +867,202 @@ vm_call_fini(lulu_VM *L, Slice<Value> results)
     // This allows the `lulu_call()` API to work properly in such cases.
     if (cf == nullptr) {
         L->window = dst;
-        return;
+    } else {
+        if (vararg_return) {
+            // Adjust VM's stack window so that it includes the last vararg.
+            // We need to revert this change as soon as we can so that further
+            // function calls see the full stack.
+            L->window = slice_pointer(raw_data(L->window), end(dst));
+        }
+
+        // We will re-enter `vm_execute()`.
+        L->saved_ip = cf->saved_ip;
     }
 
-    if (vararg_return) {
-        // Adjust VM's stack window so that it includes the last vararg.
-        // We need to revert this change as soon as we can so that further
-        // function calls see the full stack.
-        L->window = slice_pointer(raw_data(L->window), end(dst));
+    // Mostly unused after returning from a spike? This check is cheap, and
+    // only if it passes do we go through all the frames.
+    isize n = len(L->stack);
+    if (n > STACK_SIZE_INIT && vm_save_top(L) + STACK_EXTRA <= n / 8) {
+        stack_shrink(L);
     }
+}
+
+//=== THREADS ========================================================== {{{
 
-    // We will re-enter `vm_execute()`.
-    L->saved_ip = cf->saved_ip;
+lulu_VM *
+thread_new(lulu_VM *L)
+{
+    lulu_Global *g  = G(L);
+    lulu_VM     *co = object_new<lulu_VM>(L, &g->objects, VALUE_THREAD);
+    co->G       = g;
+    co->globals = L->globals;
+
+    // Reachable before allocating anything else, which may run the GC. Until
+    // then its stack and frame array are empty, so there is nothing to mark.
+    vm_push_value(L, Value::make_thread(co));
+
+    // Allocate via `L`, as `co` has no error handler of its own yet.
+    co->open_slots = slice_make<Upvalue *>(L, STACK_SIZE_INIT);
+    fill(co->open_slots, static_cast<Upvalue *>(nullptr));
+    co->stack = slice_make<Value>(L, STACK_SIZE_INIT);
+    fill(co->stack, nil);
+    co->window = slice(co->stack, 0, 0);
+    dynamic_reserve(L, &co->frames, 8);
+    return co;
 }
 
+void
+thread_free(lulu_VM *L, lulu_VM *co)
+{
+    // Upvalues not already closed by the GC, e.g. in `lulu_close()`.
+    Object *o = co->open_upvalues;
+    while (o != nullptr) {
+        Object *next = o->next();
+        object_free(L, o);
+        o = next;
+    }
+    slice_delete(L, co->stack);
+    slice_delete(L, co->open_slots);
+    dynamic_delete(L, co->frames);
+    mem_free(L, co);
+}
+
+/** @brief Starts or continues the coroutine `L` until it yields, returns or
+ *  throws.
+ *
+ * @details
+ *  A suspended coroutine has its frames intact, as the C function that
+ *  yielded simply made `vm_execute()` return. So resuming it only needs to
+ *  finish that C function's call with our arguments as its results, then
+ *  re-enter the interpreter loop for all the Lua frames below it.
+ *
+ * @note(2025-09-18)
+ *  Analogous to `ldo.c:resume()` in Lua 5.1.5.
+ */
 static void
-vm_call_mt_res(lulu_VM *L, Value *res, Value f, Value a, Value b)
+resume(lulu_VM *L, void *user_ptr)
+{
+    int    n_args = *static_cast<int *>(user_ptr);
+    Value *args   = vm_ptr_top(L) - n_args;
+    if (L->status == LULU_OK) {
+        // Starting the coroutine: its main function is right below its
+        // arguments.
+        if (vm_call_init(L, args - 1, n_args, VARARG) != CALL_LUA) {
+            return;
+        }
+    } else {
+        lulu_assert(L->status == LULU_YIELD && L->caller->is_c());
+        L->status = LULU_OK;
+        // The resume arguments are the results of `lulu_yield()`.
+        L->window = slice_pointer(raw_data(L->caller->window), vm_ptr_top(L));
+        vm_call_fini(L, slice_pointer_len(args, n_args));
+        // The main function was the C function that yielded?
+        if (L->caller == nullptr) {
+            return;
+        }
+    }
+    // Yielding across C calls is not allowed, so every remaining frame is a
+    // Lua function.
+    vm_execute(L, static_cast<int>(len(L->frames)));
+}
+
+static Error
+resume_error(lulu_VM *L, int n_args, const char *msg)
+{
+    L->window.len -= n_args;
+    vm_push_string(L, lstring_from_cstring(msg));
+    return LULU_ERROR_RUNTIME;
+}
+
+LULU_API lulu_Error
+lulu_resume(lulu_VM *L, lulu_VM *from, int n_args)
+{
+    if (L->status != LULU_OK && L->status != LULU_YIELD) {
+        return resume_error(L, n_args, "Cannot resume dead coroutine");
+    } else if (L->status == LULU_OK && len(L->frames) != 0) {
+        return resume_error(L, n_args, "Cannot resume non-suspended coroutine");
+    }
+
+    L->n_ccalls = (from != nullptr) ? from->n_ccalls + 1 : 1;
+    if (L->n_ccalls >= LULU_MAX_CCALLS) {
+        return resume_error(L, n_args, "C stack overflow");
+    }
+    L->base_ccalls = L->n_ccalls;
+
+    Error e = vm_run_protected(L, resume, &n_args);
+    if (e != LULU_OK) {
+        // The coroutine is dead, so none of its frames are ever returned to.
+        // Only the error message remains on its stack.
+        L->status = e;
+        OString *s = get_error_object(L, e);
+        upvalue_close(L, raw_data(L->stack));
+        frame_resize(L, 0);
+        L->caller = nullptr;
+        L->stack[0].set_string(s);
+        L->window = slice(L->stack, 0, 1);
+        return e;
+    }
+    return L->status;
+}
+
+LULU_API int
+lulu_yield(lulu_VM *L, int n_results)
+{
+    if (L == G(L)->main_thread) {
+        vm_runtime_error(L, "Attempt to yield from outside a coroutine");
+    } else if (L->n_ccalls > L->base_ccalls) {
+        vm_runtime_error(L,
+            "Attempt to yield across metamethod/C-call boundary");
+    }
+
+    // Only the yielded values are seen by `lulu_resume()`. Our frame's own
+    // window is untouched, so that resuming can restore it.
+    Value *top = vm_ptr_top(L);
+    L->window  = slice_pointer(top - n_results, top);
+    L->status  = LULU_YIELD;
+    return -1;
+}
+
+//=== }}} ==================================================================
+
+/**
+ * @brief
+ *      Calls the metamethod `*f` with the arguments pushed after it. If
+ *      `vm_execute()` allows it, see `METAMETHOD_DO()`, and `*f` is a Lua
+ *      function, then its frame is only pushed. That same `vm_execute()` runs
+ *      it like any other call, without recursing in C, and `finish_op()`
+ *      uses its results once it returns.
+ *
+ * @return
+ *      true if `*f` was called, else false if it was only pushed.
+ */
+static bool
+vm_call_mt(lulu_VM *L, const Value *f, int n_args, int n_rets)
+{
+    // Only the first metamethod called by the instruction may continue it.
+    // Any others are called by that one, or by C.
+    bool can_continue = L->can_continue;
+    L->can_continue   = false;
+    if (can_continue && f->is_function() && f->to_function()->is_lua()) {
+        vm_call_init(L, f, n_args, n_rets);
+        L->caller->is_continuation = true;
+        return false;
+    }
+    vm_call(L, f, n_args, n_rets);
+
+    // Above call restores previous frame, so we should have net 0 stack use
+    lulu_assert(len(L->caller->window) == len(L->window));
+    return true;
+}
+
+/**
+ * @return
+ *      The index of the result, right past the top of the stack, or -1 if
+ *      `f` was only pushed.
+ */
+static int
+vm_call_mt_binary(lulu_VM *L, Value f, Value a, Value b)
 {
-    int out_index = vm_save_index(L, res);
     vm_check_stack(L, 3);
     // Binary/unary metamethods can only ever be functions
     Value *f2 = vm_ptr_top(L);
@@ -590,11 +1072,20 @@ vm_call_mt_res(lulu_VM *L, Value *res, Value f, Value a, Value b)
     vm_push_value(L, a); // 1st argument
     vm_push_value(L, b); // 2nd argument
 
-    vm_call(L, f2, /*n_args=*/2, /*n_rets=*/1);
-    L->stack[out_index] = L->stack[ret_index];
+    if (!vm_call_mt(L, f2, /*n_args=*/2, /*n_rets=*/1)) {
+        return -1;
+    }
+    return ret_index;
+}
 
-    // Above call restores previous frame, so we should have net 0 stack use
-    lulu_assert(len(L->caller->window) == len(L->window));
+static void
+vm_call_mt_res(lulu_VM *L, Value *res, Value f, Value a, Value b)
+{
+    int out_index = vm_save_index(L, res);
+    int ret_index = vm_call_mt_binary(L, f, a, b);
+    if (ret_index != -1) {
+        L->stack[out_index] = L->stack[ret_index];
+    }
 }
 
 static void
@@ -607,9 +1098,7 @@ vm_call_mt_newindex(lulu_VM *L, Value f, Value t, Value k, Value v)
     vm_push_value(L, t);
     vm_push_value(L, k);
     vm_push_value(L, v);
-    vm_call(L, f2, /*n_args=*/3, /*n_rets=*/0);
-
-    lulu_assert(len(L->caller->window) == len(L->window));
+    vm_call_mt(L, f2, /*n_args=*/3, /*n_rets=*/0);
 }
 
 bool
@@ -706,20 +1195,10 @@ vm_table_set(lulu_VM *L, const Value *tv, const Value *k, Value v)
     debug_type_error(L, "set index of", tv);
 }
 
-static Value
-get_mt_unary(lulu_VM *L, Metamethod m, const Value *a)
-{
-    switch (a->type()) {
-    case VALUE_TABLE:    return mt_get_fast(L, a->to_table()->metatable, m);
-    case VALUE_USERDATA: return mt_get_fast(L, a->to_userdata()->metatable, m);
-    default:             return mt_get_method(L, *a, MT_LEN);
-    }
-}
-
 static void
 vm_len(lulu_VM *L, Value *res, const Value *a)
 {
-    Value mt_len = get_mt_unary(L, MT_LEN, a);
+    Value mt_len = mt_get_method(L, *a, MT_LEN);
     // Prioritize metamethod over raw type operation
     if (!mt_len.is_nil()) {
         vm_call_mt_res(L, res, mt_len, *a, *a);
@@ -728,10 +1207,10 @@ vm_len(lulu_VM *L, Value *res, const Value *a)
 
     switch (a->type()) {
     case VALUE_STRING:
-        res->set_number(static_cast<Number>(a->to_ostring()->len));
+        res->set_integral(a->to_ostring()->len);
         break;
     case VALUE_TABLE:
-        res->set_number(static_cast<Number>(table_len(a->to_table())));
+        res->set_integral(table_len(a->to_table()));
         break;
     default:
         debug_type_error(L, "get length of", a);
@@ -739,8 +1218,9 @@ vm_len(lulu_VM *L, Value *res, const Value *a)
     }
 }
 
-static bool
-vm_call_mt_binary(lulu_VM *L, Value *res, Metamethod m, Value a, Value b)
+/** @return The metamethod `m` of `a`, else of `b`, else `nil`. */
+static Value
+mt_get_binary(lulu_VM *L, Metamethod m, Value a, Value b)
 {
     // For simplicity, unary negation also delegates to here.
     lulu_assert(MT_ADD <= m && m <= MT_LEQ);
@@ -751,15 +1231,8 @@ vm_call_mt_binary(lulu_VM *L, Value *res, Metamethod m, Value a, Value b)
     // Didn't find it; try right operand
     if (mt_bin.is_nil()) {
         mt_bin = mt_get_method(L, b, m);
-        // Neither side has an appropriate metamethod?
-        if (mt_bin.is_nil()) {
-            return false;
-        }
     }
-
-    // Do __f(a, b) e.g. __add(a, b) or __lt(a, b)
-    vm_call_mt_res(L, res, mt_bin, a, b);
-    return true;
+    return mt_bin;
 }
 
 static void
@@ -787,33 +1260,407 @@ arith(lulu_VM *L, Metamethod m, Value *ra, const Value *rkb, const Value *rkc)
 
     // If metamethod itself throws, we no longer have the stack information
     // If no metamethod exists, report these culprits directly.
-    if (!vm_call_mt_binary(L, ra, m, *rkb, *rkc))  {
+    Value mt_bin = mt_get_binary(L, m, *rkb, *rkc);
+    if (mt_bin.is_nil()) {
         debug_arith_error(L, rkb, rkc);
     }
+
+    // Do __f(a, b) e.g. __add(a, b)
+    vm_call_mt_res(L, ra, mt_bin, *rkb, *rkc);
 }
 
-static void
-compare(lulu_VM *L, Metamethod m, Value *ra, const Value *rkb,
-    const Value *rkc)
+/**
+ * @return
+ *      The result of the comparison. It is meaningless if the metamethod was
+ *      only pushed; see `vm_call_mt()`.
+ */
+static bool
+compare(lulu_VM *L, Metamethod m, const Value *rkb, const Value *rkc)
 {
     Value tmp_b, tmp_c;
     if (vm_to_number(rkb, &tmp_b) && vm_to_number(rkc, &tmp_c)) {
         Number x = tmp_b.to_number();
         Number y = tmp_c.to_number();
-        bool   b;
         switch (m) {
-        case MT_LT:  b = lulu_Number_lt(x, y);  break;
-        case MT_LEQ: b = lulu_Number_leq(x, y); break;
+        case MT_LT:  return lulu_Number_lt(x, y);
+        case MT_LEQ: return lulu_Number_leq(x, y);
         default:
             lulu_panicf("Invalid Metamethod(%i)", m);
             break;
         }
-        ra->set_boolean(b);
-        return;
     }
-    if (!vm_call_mt_binary(L, ra, m, *rkb, *rkc))  {
+
+    Value mt_bin = mt_get_binary(L, m, *rkb, *rkc);
+    if (mt_bin.is_nil()) {
         debug_compare_error(L, rkb, rkc);
     }
+
+    // Do __f(a, b) e.g. __lt(a, b), whose result is only used as a condition.
+    int ret_index = vm_call_mt_binary(L, mt_bin, *rkb, *rkc);
+    return ret_index != -1 && !L->stack[ret_index].is_falsy();
+}
+
+/** @brief Rewrites the opcode of the instruction just decoded, i.e. the one
+ *  at `ip - 1`, to `op`.
+ *
+ * @note(2025-09-11)
+ *      The compiled code is otherwise immutable. Only the opcode itself may
+ *      change, so `op` must have the exact same operands as the original.
+ */
+static void
+quicken(const Instruction *ip, OpCode op)
+{
+    Instruction *i = const_cast<Instruction *>(ip - 1);
+    i->set_op(op);
+}
+
+/** @brief Finds `t[k]` for the `OP_GET_FIELD`, `OP_SET_FIELD`,
+ *  `OP_GET_GLOBAL` or `OP_SET_GLOBAL` at `ip - 1`.
+ *
+ * @details
+ *      The entry index remembered by the instruction's inline cache is tried
+ *      first. Strings are interned, so validating it only takes a pointer
+ *      comparison. Otherwise we probe the hash segment and remember where
+ *      `k` was found for next time.
+ *
+ * @return
+ *      A pointer to the value mapped to `k`, or `nullptr` if `k` is not
+ *      present in `t`.
+ */
+static Value *
+field_lookup(const Chunk *p, const Instruction *ip, Table *t, OString *k)
+{
+    int   pc    = ptr_index(p->code, ip) - 1;
+    u32  *cache = const_cast<u32 *>(&p->field_cache[pc]);
+    isize i     = static_cast<isize>(*cache);
+    if (i < len(t->entries)) {
+        Entry *e = &t->entries[i];
+        if (e->key.is_string() && e->key.to_ostring() == k) {
+            return &e->value;
+        }
+    }
+
+    i = table_find_string(t, k);
+    if (i == -1) {
+        return nullptr;
+    }
+    *cache = static_cast<u32>(i);
+    return &t->entries[i].value;
+}
+
+/**
+ * @brief
+ *      Checks if `OP_CLOSURE` can reuse `f` rather than create a new closure,
+ *      i.e. if the upvalue instructions at `ip` would capture exactly the
+ *      upvalues which `f` already has.
+ *
+ * @note(2025-09-20)
+ *      Analogous to `lvm.c:getcached()` in Lua 5.2.
+ */
+static bool
+closure_cache_hit(const Closure_Lua *f, const Closure_Lua *caller,
+    Slice<Value> window, const Instruction *ip)
+{
+    for (int i = 0, n = f->n_upvalues; i < n; i++, ip++) {
+        const Upvalue *up = f->upvalues[i];
+        if (ip->op() == OP_GET_UPVALUE) {
+            if (up != caller->upvalues[ip->b()]) {
+                return false;
+            }
+        } else if (up->value != &window[ip->b()]) {
+            // Closed upvalues never point to the stack.
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief
+ *      Runs one iteration of a generic `for` loop inline, if its generator
+ *      is one of those in `lib_base.cpp` and its state and control variable
+ *      have the types which it expects. Otherwise it is left to `vm_call()`,
+ *      which also reports any errors.
+ *
+ * @param ra
+ *      The generator, state and control variable, then the loop variables.
+ *
+ * @return
+ *      1 to continue the loop, 0 to stop it, or -1 if the generator must be
+ *      called after all.
+ */
+static int
+for_in_builtin(lulu_VM *L, Value *ra, int n_vars)
+{
+    if (!ra[0].is_function() || !ra[0].to_function()->is_c()) {
+        return -1;
+    }
+
+    Closure_C *f = &ra[0].to_function()->c;
+    int        n_results;
+    if (f->callback == base_next && ra[1].is_table()) {
+        Value k = ra[2];
+        if (!table_next(L, ra[1].to_table(), &k, &ra[4])) {
+            return 0;
+        }
+        ra[3]     = k;
+        n_results = 2;
+    } else if (f->callback == ipairs_next && ra[1].is_table()
+        && ra[2].is_number())
+    {
+        Integer i;
+        if (ra[2].is_integer()) {
+            i = ra[2].to_integer();
+        } else if (!number_to_integer(ra[2].to_number(), &i)) {
+            return -1;
+        }
+
+        // Holes may still be filled in by `__index`.
+        Table *t = ra[1].to_table();
+        Value  k = Value::make_integral(i + 1);
+        Value  v = table_get(t, k);
+        if (v.is_nil()) {
+            return (t->metatable == nullptr) ? 0 : -1;
+        }
+        ra[3]     = k;
+        ra[4]     = v;
+        n_results = 2;
+    } else if (f->callback == range_iterator && ra[1].is_number()
+        && ra[2].is_number() && f->upvalues[0].is_number())
+    {
+        Number stop = ra[1].to_number();
+        Number step = f->upvalues[0].to_number();
+        Number next = lulu_Number_add(ra[2].to_number(), step);
+        if ((step > 0) ? (next >= stop) : (next <= stop)) {
+            return 0;
+        }
+        ra[3].set_number(next);
+        n_results = 1;
+    } else {
+        return -1;
+    }
+
+    // Same as `vm_call()` would do for the variables not returned.
+    for (int i = n_results; i < n_vars; i++) {
+        ra[3 + i] = nil;
+    }
+    ra[2] = ra[3];
+    return 1;
+}
+
+/**
+ * @brief
+ *      Runs a call like `math.floor(x)` inline, if `R(A)` really is one of
+ *      the functions in `lib_math.cpp` which the compiler guessed it was and
+ *      all of its arguments are numbers. Otherwise it is left to the usual
+ *      call, which also reports any errors.
+ *
+ * @return
+ *      true if the call was done, else false.
+ */
+static bool
+call_math(Value *ra, int n_args, int n_rets)
+{
+    if (n_args == VARARG || n_args == 0 || n_rets == VARARG
+        || !ra->is_function() || !ra->to_function()->is_c())
+    {
+        return false;
+    }
+
+    for (int i = 1; i <= n_args; i++) {
+        if (!ra[i].is_number()) {
+            return false;
+        }
+    }
+
+    lulu_CFunction f = ra->to_function()->c.callback;
+    Number         x = ra[1].to_number();
+    Number         r;
+    if (f == math_abs) {
+        r = fabs(x);
+    } else if (f == math_ceil) {
+        r = ceil(x);
+    } else if (f == math_floor) {
+        r = floor(x);
+    } else if (f == math_sqrt) {
+        r = sqrt(x);
+    } else if (f == math_max) {
+        r = x;
+        for (int i = 2; i <= n_args; i++) {
+            Number n = ra[i].to_number();
+            if (n > r) {
+                r = n;
+            }
+        }
+    } else if (f == math_min) {
+        r = x;
+        for (int i = 2; i <= n_args; i++) {
+            Number n = ra[i].to_number();
+            if (n < r) {
+                r = n;
+            }
+        }
+    } else {
+        return false;
+    }
+
+    // Same as `vm_call()` would do for the results.
+    if (n_rets > 0) {
+        ra[0].set_number(r);
+    }
+    for (int i = 1; i < n_rets; i++) {
+        ra[i] = nil;
+    }
+    return true;
+}
+
+struct PCall_Status {
+    int function, n_args;
+};
+
+static void
+pcall_status(lulu_VM *L, void *user_ptr)
+{
+    PCall_Status *d = static_cast<PCall_Status *>(user_ptr);
+    vm_call(L, &L->stack[d->function], d->n_args, 0);
+}
+
+/**
+ * @brief
+ *      Runs a call like `pcall(f, x)` whose only result, if any, is its
+ *      status, if `R(A)` really is `pcall()`. As nobody can read the error
+ *      message, it is never made into a string, and the stack is restored
+ *      just as `vm_pcall()` would without pushing it.
+ *
+ * @return
+ *      true if the call was done, else false.
+ */
+static bool
+call_pcall(lulu_VM *L, Value *ra, int n_args, int n_rets)
+{
+    if (n_rets > 1 || n_args == VARARG || n_args == 0
+        || !ra->is_function() || !ra->to_function()->is_c()
+        || ra->to_function()->c.callback != base_pcall)
+    {
+        return false;
+    }
+
+    int old_cf     = frame_index(L, L->caller);
+    int old_ccalls = L->n_ccalls;
+    int ra_index   = vm_save_index(L, ra);
+
+    PCall_Status d{ra_index + 1, n_args - 1};
+    Error e = vm_run_protected(L, pcall_status, &d);
+    if (e != LULU_OK) {
+        L->n_ccalls   = old_ccalls;
+        L->lazy_error = false;
+        upvalue_close(L, &L->stack[ra_index]);
+        L->caller = frame_get(L, old_cf);
+        frame_resize(L, old_cf + 1);
+    }
+    L->window = L->caller->window;
+    if (n_rets == 1) {
+        L->stack[ra_index].set_boolean(e == LULU_OK);
+    }
+    return true;
+}
+
+/**
+ * @brief
+ *      Slow path of `BUDGET_CHECK()`, once `lulu_Global::budget_left` has run
+ *      out. Asks the budget handler, if any, for more, else throws.
+ */
+static void
+budget_exhausted(lulu_VM *L)
+{
+    lulu_Global *g    = G(L);
+    int          more = 0;
+    if (g->budget_handler != nullptr) {
+        more = g->budget_handler(L, g->budget_data);
+    }
+
+    // The handler may have called `lulu_set_budget()` itself.
+    if (!g->has_budget) {
+        return;
+    }
+    if (more <= 0) {
+        // Stay exhausted so that catching the error does not get around it.
+        g->budget_left = 0;
+        vm_runtime_error(L, "Instruction budget exceeded");
+    }
+    g->budget_left = more;
+}
+
+/**
+ * @brief
+ *      Completes the instruction at `L->saved_ip - 1`, whose Lua metamethod
+ *      or `for` generator was run in a frame of its own and just returned.
+ *      Its first result, if any, is at `*res`.
+ *
+ * @note(2025-09-20)
+ *      Analogous to `lvm.c:luaV_finishOp()` in Lua 5.4.
+ */
+static void
+finish_op(lulu_VM *L, const Value *res)
+{
+    const Instruction *ip     = L->saved_ip;
+    Instruction        inst   = ip[-1];
+    Slice<Value>       window = L->window;
+    // Quickened instructions fall back to metamethods just like their generic
+    // ones, e.g. `OP_ADD_NUM` once one of its operands is a table.
+    switch (opcode_generic(inst.op())) {
+    case OP_GET_GLOBAL:
+    case OP_GET_TABLE:
+    case OP_GET_FIELD:
+    case OP_SELF:
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_DIV:
+    case OP_MOD:
+    case OP_POW:
+    case OP_UNM:
+    case OP_LEN:
+        window[inst.a()] = *res;
+        break;
+    case OP_LT:
+    case OP_LEQ:
+        // Same as `COMPARE_RESULT()`, including the budget check of
+        // `DO_JUMP()`, e.g. for `repeat ... until a < b`. `saved_ip` still
+        // points past the comparison, should the budget run out.
+        lulu_assert(ip->op() == OP_JUMP);
+        if (!res->is_falsy() == static_cast<bool>(inst.a())) {
+            lulu_Global *g = G(L);
+            if (ip->sbx() < 0 && g->has_budget && --g->budget_left <= 0) {
+                budget_exhausted(L);
+            }
+            ip += ip->sbx();
+        }
+        ip++;
+        break;
+    case OP_FOR_IN: {
+        // Same as the end of `OP_FOR_IN`, except that the generator call
+        // already counted towards the budget.
+        Value *ra = &window[inst.a()];
+        lulu_assert(ip->op() == OP_JUMP);
+        if (!ra[3].is_nil()) {
+            // Save internal control variable.
+            ra[2] = ra[3];
+            ip += ip->sbx() + 1;
+        } else {
+            ip++;
+        }
+        break;
+    }
+    case OP_SET_GLOBAL:
+    case OP_SET_TABLE:
+    case OP_SET_FIELD:
+        break;
+    default:
+        lulu_panicf("Cannot finish opcode '%s'", opnames[inst.op()]);
+        break;
+    }
+    L->saved_ip = ip;
 }
 
 #ifdef LULU_DEBUG_TRACE_EXEC
@@ -841,6 +1688,36 @@ trace_exec(lulu_VM *L, const Instruction *ip, const Chunk *p,
 
 #endif // LULU_DEBUG_TRACE_EXEC
 
+#if LULU_AOT || LULU_JIT
+/** @brief Code compiled ahead of time takes priority over the JIT. */
+static inline const Instruction *
+native_enter(lulu_VM *L, const Closure_Lua *f, Value *base,
+    const Instruction *ip)
+{
+    // Native code loops without coming back to us, so it would never use up
+    // any of the budget.
+    if (G(L)->has_budget) {
+        return ip;
+    }
+#if LULU_AOT
+    if (f->chunk->aot != nullptr) {
+        return aot_run(L, f, base, ip);
+    }
+#endif // LULU_AOT
+#if LULU_JIT
+    return jit_enter(L, f, base, ip);
+#else // ^^^ LULU_JIT, vvv otherwise
+    return ip;
+#endif // LULU_JIT
+}
+#endif // LULU_AOT || LULU_JIT
+
+#if LULU_USE_COMPUTED_GOTO
+// Labels-as-values (`&&label` and `goto *p`) is a GNU extension.
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wpedantic"
+#endif // LULU_USE_COMPUTED_GOTO
+
 void
 vm_execute(lulu_VM *L, int n_calls)
 {
@@ -879,23 +1756,102 @@ re_entry:
     restore_window(L, &window);                                                \
 }
 
-#define BINARY_OP(number_fn, on_error_fn, metamethod, result_fn)               \
+// Like `PROTECTED_DO()`, but a Lua metamethod called by `expr` only has its
+// frame pushed; see `vm_call_mt()`. We then run it like any other call, and
+// `finish_op()` completes the current instruction once it returns. Such a
+// call, unlike any other, leaves `saved_ip` pointing into the new frame.
+#define METAMETHOD_DO(expr)                                                    \
+{                                                                              \
+    save_ip(L, ip);                                                            \
+    L->can_continue = true;                                                    \
+    expr;                                                                      \
+    L->can_continue = false;                                                   \
+    if (L->saved_ip != ip) {                                                   \
+        n_calls++;                                                             \
+        goto re_entry;                                                         \
+    }                                                                          \
+    restore_window(L, &window);                                                \
+}
+
+// Rewrite the current instruction to its specialized version for next time.
+#define QUICKEN(op) quicken(ip, op)
+
+// The guard of a quickened instruction failed. Revert it to its generic
+// version then re-dispatch it, so that it is handled properly this time.
+#define DEQUICKEN(op)                                                          \
+{                                                                              \
+    quicken(ip, op);                                                           \
+    ip--;                                                                      \
+    VM_BREAK;                                                                  \
+}
+
+#define BINARY_OP(number_fn, on_error_fn, metamethod, result_fn, quick_op)     \
 {                                                                              \
     const Value *rb = &RKB(inst), *rc = &RKC(inst);                            \
     if (rb->is_number() && rc->is_number()) {                                  \
+        QUICKEN(quick_op);                                                     \
         result_fn(number_fn(rb->to_number(), rc->to_number()));                \
     } else {                                                                   \
-        PROTECTED_DO(on_error_fn(L, metamethod, ra, rb, rc));                  \
+        METAMETHOD_DO(on_error_fn(L, metamethod, ra, rb, rc));                 \
     }                                                                          \
 }
 
+#define BINARY_OP_NUM(number_fn, result_fn, generic_op)                        \
+{                                                                              \
+    const Value *rb = &RKB(inst), *rc = &RKC(inst);                            \
+    if (!rb->is_number() || !rc->is_number()) {                                \
+        DEQUICKEN(generic_op);                                                 \
+    }                                                                          \
+    result_fn(number_fn(rb->to_number(), rc->to_number()));                    \
+}
+
+// Counts 1 call or loop iteration towards the budget, if there is one; see
+// `lulu_set_budget()`.
+#define BUDGET_CHECK()                                                         \
+{                                                                              \
+    if (G(L)->has_budget && --G(L)->budget_left <= 0) {                        \
+        PROTECTED_DO(budget_exhausted(L));                                     \
+    }                                                                          \
+}
+
+// Backward jumps close loops, so they are checked against the budget.
 #define DO_JUMP(offset)                                                        \
 {                                                                              \
-    ip += (offset);                                                            \
+    int jump_offset = (offset);                                                \
+    if (jump_offset < 0) {                                                     \
+        BUDGET_CHECK();                                                        \
+    }                                                                          \
+    ip += jump_offset;                                                         \
 }
 
+#if LULU_AOT || LULU_JIT
+// Continues in native code from `ip` if possible. Used on function entry and
+// return and on backward jumps, i.e. wherever hot code is likely to start.
+#   define NATIVE_ENTER() ip = native_enter(L, caller, raw_data(window), ip)
+#else // ^^^ LULU_AOT || LULU_JIT, vvv otherwise
+#   define NATIVE_ENTER()
+#endif // LULU_AOT || LULU_JIT
+
 #define ARITH_RESULT(n)  ra->set_number(n)
-#define ARITH_OP(fn, mt) BINARY_OP(fn, arith, mt, ARITH_RESULT)
+#define ARITH_OP(fn, mt, quick_op)                                             \
+    BINARY_OP(fn, arith, mt, ARITH_RESULT, quick_op)
+#define ARITH_OP_NUM(fn, generic_op) BINARY_OP_NUM(fn, ARITH_RESULT, generic_op)
+
+// Operands in integer form give a result in integer form, if `int_fn` says
+// it is exact. Otherwise `fn` computes the result just as it would have for
+// any other numbers.
+#define ARITH_OP_INT(int_fn, fn, generic_op)                                   \
+{                                                                              \
+    const Value *rb = &RKB(inst), *rc = &RKC(inst);                            \
+    Integer      r;                                                            \
+    if (rb->is_integer() && rc->is_integer()                                   \
+        && int_fn(rb->to_integer(), rc->to_integer(), &r))                     \
+    {                                                                          \
+        ra->set_integer(r);                                                    \
+        VM_BREAK;                                                              \
+    }                                                                          \
+    ARITH_OP_NUM(fn, generic_op);                                              \
+}
 
 #define COMPARE_RESULT(b)                                                      \
     if (b == static_cast<bool>(inst.a())) {                                    \
@@ -903,58 +1859,161 @@ re_entry:
     }                                                                          \
     ip++;                                                                      \
 
-#define COMPARE_OP(fn, mt) BINARY_OP(fn, compare, mt, COMPARE_RESULT)
+#define COMPARE_OP(fn, mt, quick_op)                                           \
+{                                                                              \
+    const Value *rb = &RKB(inst), *rc = &RKC(inst);                            \
+    if (rb->is_number() && rc->is_number()) {                                  \
+        QUICKEN(quick_op);                                                     \
+        COMPARE_RESULT(fn(rb->to_number(), rc->to_number()));                  \
+    } else {                                                                   \
+        bool b;                                                                \
+        METAMETHOD_DO(b = compare(L, mt, rb, rc));                             \
+        COMPARE_RESULT(b);                                                     \
+    }                                                                          \
+}
+#define COMPARE_OP_NUM(fn, generic_op)                                         \
+    BINARY_OP_NUM(fn, COMPARE_RESULT, generic_op)
+
+// Exact integers compare the same way as their number values.
+#define COMPARE_OP_INT(int_op, fn, generic_op)                                 \
+{                                                                              \
+    const Value *rb = &RKB(inst), *rc = &RKC(inst);                            \
+    if (rb->is_integer() && rc->is_integer()) {                                \
+        COMPARE_RESULT((rb->to_integer() int_op rc->to_integer()));            \
+        VM_BREAK;                                                              \
+    }                                                                          \
+    COMPARE_OP_NUM(fn, generic_op);                                            \
+}
 
 #ifdef LULU_DEBUG_TRACE_EXEC
     int pad = debug_get_pad(chunk);
+#   define TRACE_EXEC() trace_exec(L, ip, chunk, window, pad)
+#else // ^^^ LULU_DEBUG_TRACE_EXEC, vvv otherwise
+#   define TRACE_EXEC()
 #endif // LULU_DEBUG_TRACE_EXEC
 
-    for (;;) {
-        Instruction inst = *ip++;
-        /** @warning(2025-09-02) Bounds-check breaks when C function returns 0
-         *  values! */
-        Value *ra   = &RA(inst);
+/** @warning(2025-09-02) Bounds-check of `ra` breaks when C function returns 0
+ *  values! */
+#define FETCH()                                                                \
+{                                                                              \
+    inst = *ip++;                                                              \
+    ra   = &RA(inst);                                                          \
+    TRACE_EXEC();                                                              \
+}
 
-#ifdef LULU_DEBUG_TRACE_EXEC
-        trace_exec(L, ip, chunk, window, pad);
-#endif // LULU_DEBUG_TRACE_EXEC
+#if LULU_USE_COMPUTED_GOTO
+
+    /**
+     * @brief
+     *      Each handler fetches and jumps to the next one by itself, so that
+     *      every opcode gets its own indirect branch which the CPU can predict
+     *      separately. Analogous to `ljumptab.h` in Lua 5.4.
+     *
+     * @note(2025-09-10)
+     *      Must be in the exact same order as `OpCode`!
+     */
+    static const void *const dispatch_table[] = {
+        &&CASE_OP_MOVE,       &&CASE_OP_CONSTANT,   &&CASE_OP_NIL,
+        &&CASE_OP_BOOL,       &&CASE_OP_GET_GLOBAL, &&CASE_OP_SET_GLOBAL,
+        &&CASE_OP_NEW_TABLE,  &&CASE_OP_GET_TABLE,  &&CASE_OP_SET_TABLE,
+        &&CASE_OP_GET_FIELD,  &&CASE_OP_SET_FIELD,  &&CASE_OP_SET_ARRAY,
+        &&CASE_OP_GET_UPVALUE, &&CASE_OP_SET_UPVALUE,
+        &&CASE_OP_ADD,        &&CASE_OP_SUB,        &&CASE_OP_MUL,
+        &&CASE_OP_DIV,        &&CASE_OP_MOD,        &&CASE_OP_POW,
+        &&CASE_OP_EQ,         &&CASE_OP_LT,         &&CASE_OP_LEQ,
+        &&CASE_OP_UNM,        &&CASE_OP_NOT,        &&CASE_OP_LEN,
+        &&CASE_OP_CONCAT,     &&CASE_OP_TEST,       &&CASE_OP_TEST_SET,
+        &&CASE_OP_JUMP,       &&CASE_OP_JUMP_IF,    &&CASE_OP_JUMP_IF_NOT,
+        &&CASE_OP_FOR_PREP,   &&CASE_OP_FOR_LOOP,   &&CASE_OP_FOR_IN,
+        &&CASE_OP_CALL,       &&CASE_OP_TAIL_CALL,  &&CASE_OP_SELF,
+        &&CASE_OP_CLOSURE,    &&CASE_OP_CLOSE,      &&CASE_OP_RETURN,
+        &&CASE_OP_CALL_MATH,
+
+        &&CASE_OP_ADD_NUM,    &&CASE_OP_SUB_NUM,    &&CASE_OP_MUL_NUM,
+        &&CASE_OP_DIV_NUM,    &&CASE_OP_MOD_NUM,    &&CASE_OP_POW_NUM,
+        &&CASE_OP_LT_NUM,     &&CASE_OP_LEQ_NUM,    &&CASE_OP_GET_TABLE_INT,
+        &&CASE_OP_GET_TABLE_STR, &&CASE_OP_SET_TABLE_INT,
+    };
+    static_assert(count_of(dispatch_table) == OPCODE_COUNT,
+        "Please update `dispatch_table` to match `OpCode`");
+
+#   define VM_DISPATCH(op) goto *dispatch_table[op];
+#   define VM_CASE(op)     CASE_##op:
+#   define VM_BREAK                                                            \
+    {                                                                          \
+        FETCH();                                                               \
+        goto *dispatch_table[inst.op()];                                       \
+    }
+
+#else // ^^^ LULU_USE_COMPUTED_GOTO, vvv otherwise
 
-        OpCode op = inst.op();
-        switch (op) {
-        case OP_MOVE:
+#   define VM_DISPATCH(op) switch (op)
+#   define VM_CASE(op)     case op:
+#   define VM_BREAK        break
+
+#endif // LULU_USE_COMPUTED_GOTO
+
+    Instruction inst;
+    Value      *ra;
+    NATIVE_ENTER();
+    for (;;) {
+        FETCH();
+        VM_DISPATCH(inst.op()) {
+        VM_CASE(OP_MOVE)
             *ra = RB(inst);
-            break;
-        case OP_CONSTANT:
+            VM_BREAK;
+        VM_CASE(OP_CONSTANT)
             *ra = KBX(inst);
-            break;
-        case OP_NIL:
+            VM_BREAK;
+        VM_CASE(OP_NIL)
             fill(slice_pointer(ra, &RB(inst) + 1), nil);
-            break;
-        case OP_BOOL:
+            VM_BREAK;
+        VM_CASE(OP_BOOL)
             ra->set_boolean(static_cast<bool>(inst.b()));
             if (static_cast<bool>(inst.c())) {
                 ip++;
             }
-            break;
-        case OP_GET_GLOBAL: {
+            VM_BREAK;
+        VM_CASE(OP_GET_GLOBAL) {
             Value k = KBX(inst);
-            Value v;
-            PROTECTED_DO(
-                if (!vm_table_get(L, &L->globals, k, &v)) {
+            // Fast path: present globals need no metatable lookup at all.
+            if (L->globals.is_table()) {
+                Table *g   = L->globals.to_table();
+                Value *src = field_lookup(chunk, ip, g, k.to_ostring());
+                if (src != nullptr && !src->is_nil()) {
+                    *ra = *src;
+                    VM_BREAK;
+                }
+            }
+            // `__index` results are written to the stack, so `ra` must be
+            // given directly rather than some local.
+            METAMETHOD_DO(
+                if (!vm_table_get(L, &L->globals, k, ra)) {
                     const char *s = k.to_cstring();
                     vm_runtime_error(L,
                         "Attempt to read undefined variable '%s'", s);
                 }
             );
-            *ra = v;
-            break;
+            VM_BREAK;
         }
-        case OP_SET_GLOBAL: {
+        VM_CASE(OP_SET_GLOBAL) {
             Value k = KBX(inst);
-            PROTECTED_DO(vm_table_set(L, &L->globals, &k, *ra));
-            break;
+            if (L->globals.is_table()) {
+                Table *g   = L->globals.to_table();
+                Value *dst = field_lookup(chunk, ip, g, k.to_ostring());
+                if (dst != nullptr
+                    && (!dst->is_nil() || g->metatable == nullptr))
+                {
+                    // luaC_barriert(L, g, *ra);
+                    table_invalidate_flags(g);
+                    *dst = *ra;
+                    VM_BREAK;
+                }
+            }
+            METAMETHOD_DO(vm_table_set(L, &L->globals, &k, *ra));
+            VM_BREAK;
         }
-        case OP_NEW_TABLE: {
+        VM_CASE(OP_NEW_TABLE) {
             isize  n_hash  = floating_byte_decode(inst.b());
             isize  n_array = floating_byte_decode(inst.c());
             Table *t       = table_new(L, n_hash, n_array);
@@ -962,21 +2021,69 @@ re_entry:
             // Must occur AFTER setting `ra` so that the table is on the stack!
             // May throw a memory error hence we protect the call.
             // PROTECTED_DO(gc_check(L)); // Protect(luaC_checkGC(L));
-            break;
+            VM_BREAK;
         }
-        case OP_GET_TABLE: {
+        VM_CASE(OP_GET_TABLE) {
             const Value *t = &RB(inst);
             const Value *k = &RKC(inst);
-            PROTECTED_DO(vm_table_get(L, t, *k, ra));
-            break;
+            if (t->is_table()) {
+                if (k->is_number()) {
+                    QUICKEN(OP_GET_TABLE_INT);
+                } else if (k->is_string()) {
+                    QUICKEN(OP_GET_TABLE_STR);
+                }
+            }
+            METAMETHOD_DO(vm_table_get(L, t, *k, ra));
+            VM_BREAK;
         }
-        case OP_SET_TABLE: {
+        VM_CASE(OP_SET_TABLE) {
             const Value *k = &RKB(inst);
             const Value *v = &RKC(inst);
-            PROTECTED_DO(vm_table_set(L, ra, k, *v));
-            break;
+            if (ra->is_table() && k->is_number()) {
+                QUICKEN(OP_SET_TABLE_INT);
+            }
+            METAMETHOD_DO(vm_table_set(L, ra, k, *v));
+            VM_BREAK;
+        }
+        VM_CASE(OP_GET_FIELD) {
+            const Value *t = &RB(inst);
+            const Value *k = &RKC(inst);
+            if (t->is_table()) {
+                // Absent or `nil` fields need to check for `__index`.
+                Table *tt  = t->to_table();
+                Value *src = field_lookup(chunk, ip, tt, k->to_ostring());
+                if (src != nullptr && !src->is_nil()) {
+                    *ra = *src;
+                    VM_BREAK;
+                } else if (tt->metatable == nullptr) {
+                    *ra = nil;
+                    VM_BREAK;
+                }
+            }
+            METAMETHOD_DO(vm_table_get(L, t, *k, ra));
+            VM_BREAK;
+        }
+        VM_CASE(OP_SET_FIELD) {
+            const Value *k = &RKB(inst);
+            const Value *v = &RKC(inst);
+            if (ra->is_table()) {
+                // Only existing fields can be assigned directly. New fields
+                // may need a rehash or may need to check for `__newindex`.
+                Table *t   = ra->to_table();
+                Value *dst = field_lookup(chunk, ip, t, k->to_ostring());
+                if (dst != nullptr
+                    && (!dst->is_nil() || t->metatable == nullptr))
+                {
+                    // luaC_barriert(L, t, v);
+                    table_invalidate_flags(t);
+                    *dst = *v;
+                    VM_BREAK;
+                }
+            }
+            METAMETHOD_DO(vm_table_set(L, ra, k, *v));
+            VM_BREAK;
         }
-        case OP_SET_ARRAY: {
+        VM_CASE(OP_SET_ARRAY) {
             isize n      = inst.b();
             isize offset = static_cast<isize>(inst.c()) * FIELDS_PER_FLUSH;
 
@@ -988,29 +2095,42 @@ re_entry:
             // Guaranteed to be valid because this only occurs in table
             // contructors.
             Table *t = ra->to_table();
-            for (isize i = 1; i <= n; i++) {
-                Value *v = table_set_integer(L, t, offset + i);
-                *v = ra[i];
+
+            // `OP_NEW_TABLE` already made room for a fixed number of items,
+            // so this only grows the array after variadic ones. Those may be
+            // none at all, e.g. `{f()}`, when `t` may not have an array yet.
+            if (n > 0) {
+                if (offset + n > len(t->array)) {
+                    PROTECTED_DO(table_reserve_array(L, t, offset + n));
+                }
+                Slice<Value> dst = slice(t->array, offset, offset + n);
+                copy(dst, slice_pointer_len(&RA(inst) + 1, n));
             }
-            break;
+
+            if (inst.b() == VARARG) {
+                // Undo the window adjustment from the variadic call.
+                L->window = L->caller->window;
+                restore_window(L, &window);
+            }
+            VM_BREAK;
         }
-        case OP_GET_UPVALUE: {
+        VM_CASE(OP_GET_UPVALUE) {
             Upvalue *up = caller->upvalues[inst.b()];
             *ra = *up->value;
-            break;
+            VM_BREAK;
         }
-        case OP_SET_UPVALUE: {
+        VM_CASE(OP_SET_UPVALUE) {
             Upvalue *up = caller->upvalues[inst.b()];
             *up->value = *ra;
-            break;
+            VM_BREAK;
         }
-        case OP_ADD: ARITH_OP(lulu_Number_add, MT_ADD); break;
-        case OP_SUB: ARITH_OP(lulu_Number_sub, MT_SUB); break;
-        case OP_MUL: ARITH_OP(lulu_Number_mul, MT_MUL); break;
-        case OP_DIV: ARITH_OP(lulu_Number_div, MT_DIV); break;
-        case OP_MOD: ARITH_OP(lulu_Number_mod, MT_MOD); break;
-        case OP_POW: ARITH_OP(lulu_Number_pow, MT_POW); break;
-        case OP_EQ: {
+        VM_CASE(OP_ADD) ARITH_OP(lulu_Number_add, MT_ADD, OP_ADD_NUM); VM_BREAK;
+        VM_CASE(OP_SUB) ARITH_OP(lulu_Number_sub, MT_SUB, OP_SUB_NUM); VM_BREAK;
+        VM_CASE(OP_MUL) ARITH_OP(lulu_Number_mul, MT_MUL, OP_MUL_NUM); VM_BREAK;
+        VM_CASE(OP_DIV) ARITH_OP(lulu_Number_div, MT_DIV, OP_DIV_NUM); VM_BREAK;
+        VM_CASE(OP_MOD) ARITH_OP(lulu_Number_mod, MT_MOD, OP_MOD_NUM); VM_BREAK;
+        VM_CASE(OP_POW) ARITH_OP(lulu_Number_pow, MT_POW, OP_POW_NUM); VM_BREAK;
+        VM_CASE(OP_EQ) {
             Value left  = RKB(inst);
             Value right = RKC(inst);
 
@@ -1021,41 +2141,41 @@ re_entry:
                 }
             );
             ip++;
-            break;
+            VM_BREAK;
         }
-        case OP_LT:  COMPARE_OP(lulu_Number_lt, MT_LT); break;
-        case OP_LEQ: COMPARE_OP(lulu_Number_leq, MT_LEQ); break;
-        case OP_UNM: {
+        VM_CASE(OP_LT)  COMPARE_OP(lulu_Number_lt, MT_LT, OP_LT_NUM); VM_BREAK;
+        VM_CASE(OP_LEQ) COMPARE_OP(lulu_Number_leq, MT_LEQ, OP_LEQ_NUM); VM_BREAK;
+        VM_CASE(OP_UNM) {
             Value *rb = &RB(inst);
             Value tmp;
             if (vm_to_number(rb, &tmp)) {
                 ra->set_number(lulu_Number_unm(tmp.to_number()));
-                break;
+                VM_BREAK;
             }
-            Value mt_unm = get_mt_unary(L, MT_UNM, rb);
-            PROTECTED_DO(
+            Value mt_unm = mt_get_method(L, *rb, MT_UNM);
+            METAMETHOD_DO(
                 if (mt_unm.is_nil()) {
                     debug_arith_error(L, rb, rb);
                 }
                 vm_call_mt_res(L, ra, mt_unm, *rb, *rb);
             );
-            break;
+            VM_BREAK;
         }
-        case OP_NOT:
+        VM_CASE(OP_NOT)
             ra->set_boolean(RB(inst).is_falsy());
-            break;
-        case OP_LEN: {
+            VM_BREAK;
+        VM_CASE(OP_LEN) {
             Value *rb = &window[inst.b()];
-            PROTECTED_DO(vm_len(L, ra, rb));
-            break;
+            METAMETHOD_DO(vm_len(L, ra, rb));
+            VM_BREAK;
         }
-        case OP_CONCAT: {
+        VM_CASE(OP_CONCAT) {
             Slice<Value> args = slice_pointer(&RB(inst), &RC(inst) + 1);
             PROTECTED_DO(vm_concat(L, ra, args));
             // gc_check(L); // luaC_checkGC(L);
-            break;
+            VM_BREAK;
         }
-        case OP_TEST: {
+        VM_CASE(OP_TEST) {
             bool cond = inst.c();
             bool test = (!ra->is_falsy() == cond);
 
@@ -1069,9 +2189,9 @@ re_entry:
             // If `DO_JUMP()` wasn't called then `ip` still points to `OP_JUMP`,
             // so increment to skip over it.
             ip++;
-            break;
+            VM_BREAK;
         }
-        case OP_TEST_SET: {
+        VM_CASE(OP_TEST_SET) {
             bool  cond = inst.c();
             Value rb   = RB(inst);
             bool  test = (!rb.is_falsy() == cond);
@@ -1081,12 +2201,31 @@ re_entry:
                 DO_JUMP(ip->sbx());
             }
             ip++;
-            break;
+            VM_BREAK;
         }
-        case OP_JUMP:
+        VM_CASE(OP_JUMP)
             DO_JUMP(inst.sbx());
-            break;
-        case OP_FOR_PREP: {
+            if (inst.sbx() < 0) {
+                NATIVE_ENTER();
+            }
+            VM_BREAK;
+        VM_CASE(OP_JUMP_IF)
+            if (!ra->is_falsy()) {
+                DO_JUMP(inst.sbx());
+                if (inst.sbx() < 0) {
+                    NATIVE_ENTER();
+                }
+            }
+            VM_BREAK;
+        VM_CASE(OP_JUMP_IF_NOT)
+            if (ra->is_falsy()) {
+                DO_JUMP(inst.sbx());
+                if (inst.sbx() < 0) {
+                    NATIVE_ENTER();
+                }
+            }
+            VM_BREAK;
+        VM_CASE(OP_FOR_PREP) {
             Value *index = &ra[0];
             Value *limit = &ra[1];
             Value *incr  = &ra[2];
@@ -1102,14 +2241,45 @@ re_entry:
                 vm_runtime_error(L, "'for' increment must be a number");
             }
 
+            // Loop in integer form if all of the control variables allow it.
+            // `OP_FOR_LOOP` checks only the internal index to determine this.
+            // Every index up to `limit + incr` must also be exact, so that we
+            // stop exactly when the floating-point version would.
+            Integer i, n, step;
+            if (number_to_exact_integer(index->to_number(), &i)
+                && number_to_exact_integer(limit->to_number(), &n)
+                && number_to_exact_integer(incr->to_number(), &step)
+                && integer_is_exact(i - step)
+                && integer_is_exact(n + step))
+            {
+                index->set_integer(i - step);
+                limit->set_integer(n);
+                incr->set_integer(step);
+                DO_JUMP(inst.sbx());
+                VM_BREAK;
+            }
+
             // @todo(2025-07-28) Should we detect increment of 0?
             lulu_Number next =
                 lulu_Number_sub(index->to_number(), incr->to_number());
             index->set_number(next);
             DO_JUMP(inst.sbx());
-            break;
+            VM_BREAK;
         }
-        case OP_FOR_LOOP: {
+        VM_CASE(OP_FOR_LOOP) {
+            if (ra[0].is_integer()) {
+                Integer limit = ra[1].to_integer();
+                Integer incr  = ra[2].to_integer();
+                Integer next  = ra[0].to_integer() + incr;
+                if ((0 < incr) ? (next <= limit) : (limit <= next)) {
+                    ra[0].set_integer(next);
+                    ra[3].set_integer(next);
+                    DO_JUMP(inst.sbx());
+                    NATIVE_ENTER();
+                }
+                VM_BREAK;
+            }
+
             lulu_Number index = ra[0].to_number();
             lulu_Number limit = ra[1].to_number();
             lulu_Number incr  = ra[2].to_number();
@@ -1121,55 +2291,107 @@ re_entry:
                     : lulu_Number_leq(limit, next) // incr <= 0 => next >= limit
             )
             {
-                DO_JUMP(inst.sbx());
                 // Update internal index.
                 ra[0].set_number(next);
 
                 // Then update external index.
                 ra[3].set_number(next);
+                DO_JUMP(inst.sbx());
+                NATIVE_ENTER();
             }
-            break;
+            VM_BREAK;
         }
-        case OP_FOR_IN: {
-            Value *call_base = ra + 3;
-
-            // Prepare call so that its registers can be overridden.
-            call_base[0] = ra[0]; // generator function
-            call_base[1] = ra[1]; // invariant state variable
-            call_base[2] = ra[2]; // internal control variable
-
-            // Registers for generator function, invariant state and index.
-            int top   = ptr_index(window, call_base + 3);
-            L->window = slice_until(window, top);
-
+        VM_CASE(OP_FOR_IN) {
             // Number of user-facing variables to set.
             u16 n_vars = inst.c();
 
-            /** @note(2025-09-01) May call another vm_execute(). */
-            PROTECTED_DO(vm_call(L, call_base, 2, n_vars));
+            save_ip(L, ip); // `next()` may throw on invalid keys.
+            int more = for_in_builtin(L, ra, n_vars);
+            // Each iteration counts once towards the budget: either as the
+            // generator call, or else as the jump back to the loop body.
+            bool counted = (more == -1);
+            if (more == -1) {
+                // Calling the generator counts, like any other call.
+                BUDGET_CHECK();
+                Value *call_base = &RA(inst) + 3;
+
+                // Prepare call so that its registers can be overridden.
+                call_base[0] = ra[0]; // generator function
+                call_base[1] = ra[1]; // invariant state variable
+                call_base[2] = ra[2]; // internal control variable
+
+                // Registers for generator function, invariant state and index.
+                int top   = ptr_index(window, call_base + 3);
+                L->window = slice_until(window, top);
+
+                // A Lua generator is run by us, in a frame of its own.
+                // `finish_op()` then does the rest of this instruction.
+                if (call_base->is_function()
+                    && call_base->to_function()->is_lua())
+                {
+                    vm_call_init(L, call_base, 2, n_vars);
+                    L->caller->is_continuation = true;
+                    n_calls++;
+                    goto re_entry;
+                }
 
-            // Ensure our returned stack frame is correct.
-            // Otherwise, it may be too short, causing length checks to fail.
-            lulu_assert(len(window) == len(L->caller->window));
-            lulu_assert(len(L->window) == len(L->caller->window));
+                /** @note(2025-09-01) May call another vm_execute(). */
+                PROTECTED_DO(vm_call(L, call_base, 2, n_vars));
 
-            call_base = &RA(inst) + 3;
+                // Ensure our returned stack frame is correct.
+                // Otherwise, it may be too short, causing length checks to
+                // fail.
+                lulu_assert(len(window) == len(L->caller->window));
+                lulu_assert(len(L->window) == len(L->caller->window));
 
-            // Continue loop?
-            if (!call_base->is_nil()) {
-                // Save internal control variable.
-                call_base[-1] = call_base[0];
-                DO_JUMP(ip->sbx());
+                call_base = &RA(inst) + 3;
+                more      = !call_base->is_nil();
+                if (more) {
+                    // Save internal control variable.
+                    call_base[-1] = call_base[0];
+                }
             }
-            ip++;
-            break;
+
+            // Continue loop? The `OP_JUMP` after us goes back to its body.
+            if (more) {
+                if (counted) {
+                    ip += ip->sbx() + 1;
+                } else {
+                    DO_JUMP(ip->sbx() + 1);
+                }
+                NATIVE_ENTER();
+            } else {
+                ip++;
+            }
+            VM_BREAK;
+        }
+        VM_CASE(OP_CALL_MATH) {
+            if (call_math(ra, inst.b(), inst.c())) {
+                VM_BREAK;
+            }
+            // Otherwise it is an ordinary call after all.
+            goto call;
         }
-        case OP_CALL: {
+        VM_CASE(OP_CALL) {
+call:
             int n_args = inst.b();
             int n_rets = inst.c();
 
             // Next call may throw an error
             save_ip(L, ip);
+            BUDGET_CHECK();
+
+            if (ra->is_function() && ra->to_function()->base.is_light
+                && n_rets != VARARG)
+            {
+                call_light(L, ra, n_args, n_rets);
+                window = L->window;
+                VM_BREAK;
+            }
+            if (call_pcall(L, ra, n_args, n_rets)) {
+                window = L->window;
+                VM_BREAK;
+            }
 
             // @note(2025-08-29) `vm->window` may have been changed by this!
             Call_Type t = vm_call_init(L, ra, n_args, n_rets);
@@ -1180,6 +2402,9 @@ re_entry:
 #endif // LULU_DEBUG_TRACE_EXEC
                 // Local `window` will be re-assigned properly anyway.
                 goto re_entry;
+            } else if (t == CALL_YIELD) {
+                // Our frames stay as they are; `lulu_resume()` continues them.
+                return;
             }
             /** @brief Need to fix local `window` because it may be dangling
              *  otherwise. This is mainly an issue for variadic calls.
@@ -1187,17 +2412,49 @@ re_entry:
              * @note(2025-08-27) Concept check: tests/factorial.lua
              */
             window = L->window;
-            break;
+            VM_BREAK;
         }
-        case OP_SELF: {
+        VM_CASE(OP_TAIL_CALL) {
+            int n_args = inst.b();
+            save_ip(L, ip);
+            BUDGET_CHECK();
+
+            // C functions (and non-functions, which throw) need no frame of
+            // ours to be replaced. The next `OP_RETURN` passes along their
+            // results just as it would for any other variadic call.
+            if (!ra->is_function() || ra->to_function()->is_c()) {
+                if (vm_call_init(L, ra, n_args, VARARG) == CALL_YIELD) {
+                    return;
+                }
+                window = L->window;
+                VM_BREAK;
+            }
+
+            if (L->open_upvalues != nullptr) {
+                upvalue_close(L, &window[0]);
+            }
+            vm_call_tail(L, ra, n_args);
+            goto re_entry;
+        }
+        VM_CASE(OP_SELF) {
             Value *self  = &RB(inst);
             Value  field = RKC(inst);
             ra[1] = *self;
-            PROTECTED_DO(vm_table_get(L, self, field, ra));
-            break;
+            METAMETHOD_DO(vm_table_get(L, self, field, ra));
+            VM_BREAK;
         }
-        case OP_CLOSURE: {
-            Closure *f = closure_lua_new(L, chunk->children[inst.bx()]);
+        VM_CASE(OP_CLOSURE) {
+            Chunk       *p      = chunk->children[inst.bx()];
+            Closure_Lua *cached = p->cache;
+            if (cached != nullptr && closure_cache_hit(cached, caller, window,
+                ip))
+            {
+                ra->set_function(reinterpret_cast<Closure *>(cached));
+                ip += p->n_upvalues;
+                VM_BREAK;
+            }
+
+            Closure *f = closure_lua_new(L, p);
             // Ensure closure lives on the stack already to avoid collection.
             // This also ensures the upvalues are not collected.
             ra->set_function(f);
@@ -1217,49 +2474,183 @@ re_entry:
                 }
                 ip++;
             }
+            p->cache = f->to_lua();
             // PROTECTED_DO(gc_check(L)); // Protect(luaC_checkGC(L));
-            break;
+            VM_BREAK;
         }
-        case OP_CLOSE:
+        VM_CASE(OP_CLOSE)
             upvalue_close(L, ra);
-            break;
-        case OP_RETURN: {
+            VM_BREAK;
+        VM_CASE(OP_RETURN) {
             int n_rets = inst.b();
             if (n_rets == VARARG) {
-                n_rets = len(L->window);
+                // Results end at the last result of the variadic call.
+                n_rets = static_cast<int>(vm_ptr_top(L) - ra);
             }
 
             if (L->open_upvalues != nullptr) {
                 upvalue_close(L, &window[0]);
             }
 
+            // Our results are moved to where our function was.
+            bool is_continuation = L->caller->is_continuation;
+            int  res_index       = ptr_index(L->stack, raw_data(window)) - 1;
+
             vm_call_fini(L, slice_pointer_len(ra, n_rets));
             n_calls--;
             if (n_calls == 0) {
                 return;
             }
+            if (is_continuation) {
+                finish_op(L, &L->stack[res_index]);
+            }
 #if LULU_DEBUG_TRACE_EXEC
             printf("\n=== END CALL ===\n\n");
 #endif // LULU_DEBUG_TRACE_EXEC
             goto re_entry;
         }
+        VM_CASE(OP_ADD_NUM)
+            ARITH_OP_INT(integer_add, lulu_Number_add, OP_ADD);
+            VM_BREAK;
+        VM_CASE(OP_SUB_NUM)
+            ARITH_OP_INT(integer_sub, lulu_Number_sub, OP_SUB);
+            VM_BREAK;
+        VM_CASE(OP_MUL_NUM)
+            ARITH_OP_INT(integer_mul, lulu_Number_mul, OP_MUL);
+            VM_BREAK;
+        VM_CASE(OP_DIV_NUM) ARITH_OP_NUM(lulu_Number_div, OP_DIV); VM_BREAK;
+        VM_CASE(OP_MOD_NUM) ARITH_OP_NUM(lulu_Number_mod, OP_MOD); VM_BREAK;
+        VM_CASE(OP_POW_NUM) ARITH_OP_NUM(lulu_Number_pow, OP_POW); VM_BREAK;
+        VM_CASE(OP_LT_NUM)
+            COMPARE_OP_INT(<, lulu_Number_lt, OP_LT);
+            VM_BREAK;
+        VM_CASE(OP_LEQ_NUM)
+            COMPARE_OP_INT(<=, lulu_Number_leq, OP_LEQ);
+            VM_BREAK;
+        VM_CASE(OP_GET_TABLE_INT) {
+            const Value *t = &RB(inst);
+            const Value *k = &RKC(inst);
+            if (!t->is_table() || !k->is_number()) {
+                DEQUICKEN(OP_GET_TABLE);
+            }
+
+            // Hit in the array segment? Otherwise, it may be in the hash
+            // segment or we may need to call `__index`.
+            Table  *tt = t->to_table();
+            Integer i;
+            if (k->is_integer()) {
+                i = k->to_integer();
+                if (1 <= i && i <= len(tt->array)) {
+                    const Value *v = &tt->array[i - 1];
+                    if (!v->is_nil() || tt->metatable == nullptr) {
+                        *ra = *v;
+                        VM_BREAK;
+                    }
+                }
+            } else if (number_to_integer(k->to_number(), &i)
+                && 1 <= i && i <= len(tt->array))
+            {
+                Value v = tt->array[i - 1];
+                if (!v.is_nil() || tt->metatable == nullptr) {
+                    *ra = v;
+                    VM_BREAK;
+                }
+            }
+            METAMETHOD_DO(vm_table_get(L, t, *k, ra));
+            VM_BREAK;
+        }
+        VM_CASE(OP_GET_TABLE_STR) {
+            const Value *t = &RB(inst);
+            const Value *k = &RKC(inst);
+            if (!t->is_table() || !k->is_string()) {
+                DEQUICKEN(OP_GET_TABLE);
+            }
+
+            Table *tt = t->to_table();
+            Value  v  = table_get_string(tt, k->to_ostring());
+            if (!v.is_nil() || tt->metatable == nullptr) {
+                *ra = v;
+                VM_BREAK;
+            }
+            METAMETHOD_DO(vm_table_get(L, t, *k, ra));
+            VM_BREAK;
+        }
+        VM_CASE(OP_SET_TABLE_INT) {
+            const Value *k = &RKB(inst);
+            const Value *v = &RKC(inst);
+            if (!ra->is_table() || !k->is_number()) {
+                DEQUICKEN(OP_SET_TABLE);
+            }
+
+            // Slot in the array segment? `nil` slots can only be assigned
+            // directly if there is no metatable, as there may be `__newindex`.
+            Table  *t = ra->to_table();
+            Integer i;
+            if (k->is_integer()) {
+                i = k->to_integer();
+            } else if (!number_to_integer(k->to_number(), &i)) {
+                i = 0;
+            }
+            if (1 <= i && i <= len(t->array)) {
+                Value *dst = &t->array[i - 1];
+                if (!dst->is_nil() || t->metatable == nullptr) {
+                    // luaC_barriert(L, t, v);
+                    *dst = *v;
+                    VM_BREAK;
+                }
+            }
+            METAMETHOD_DO(vm_table_set(L, ra, k, *v));
+            VM_BREAK;
+        }
+#if !LULU_USE_COMPUTED_GOTO
         default:
-            lulu_panicf("Invalid OpCode(%i)", op);
+            lulu_panicf("Invalid OpCode(%i)", inst.op());
+#endif // !LULU_USE_COMPUTED_GOTO
         }
     }
 }
 
+#if LULU_USE_COMPUTED_GOTO
+#   pragma GCC diagnostic pop
+#endif // LULU_USE_COMPUTED_GOTO
+
 void
 vm_concat(lulu_VM *L, Value *ra, Slice<Value> args)
 {
+    // Numbers are only formatted, not interned, as just their text is needed.
+    // Each is nul-terminated in the builder so that we can find it again.
     Builder *b = vm_get_builder(L);
-    for (Value &s : args) {
-        /** @todo(2025-09-01) Call metamethod? */
-        if (!vm_to_string(L, &s)) {
-            debug_type_error(L, "concatentate", &s);
+    isize    n = 0;
+    for (const Value &v : args) {
+        if (v.is_string()) {
+            n += v.to_ostring()->len;
+        } else if (v.is_number()) {
+            isize start = builder_len(*b);
+            builder_write_number(L, b, v.to_number());
+            n += builder_len(*b) - start;
+            builder_write_char(L, b, '\0');
+        } else {
+            /** @todo(2025-09-01) Call metamethod? */
+            debug_type_error(L, "concatentate", &v);
+        }
+    }
+
+    // Write and hash the result in place; nothing else allocates until then.
+    OString    *os     = ostring_alloc(L, n);
+    char       *dst    = os->data;
+    const char *number = raw_data(b->buffer);
+    u32         hash   = FNV1A_OFFSET;
+    for (const Value &v : args) {
+        LString text;
+        if (v.is_string()) {
+            text = v.to_lstring();
+        } else {
+            text = lstring_from_cstring(number);
+            number += len(text) + 1;
         }
-        builder_write_lstring(L, b, s.to_lstring());
+        hash = hash_string_write(hash, dst, text);
+        dst += len(text);
     }
-    OString *os = ostring_new(L, builder_to_string(*b));
-    ra->set_string(os);
+    os->hash = hash;
+    ra->set_string(ostring_intern(L, os));
 }
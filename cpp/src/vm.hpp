@@ -1,7 +1,9 @@
 #pragma once
 
+#include <setjmp.h> // jmp_buf
 #include <stdlib.h> // exit
 
+#include "dynamic.hpp"
 #include "object.hpp"
 #include "private.hpp"
 #include "stream.hpp"
@@ -10,10 +12,24 @@
 
 using Error = lulu_Error;
 
-static constexpr int MAX_STACK = 256;
+/** @brief Number of stack slots allocated on startup. The stack grows as
+ *  needed, and shrinks back towards this size once the extra slots are mostly
+ *  unused again. Analogous to `BASIC_STACK_SIZE` in Lua 5.1.5. */
+static constexpr int STACK_SIZE_INIT = 2 * LULU_STACK_MIN;
+
+/** @brief Slots always allocated past those guaranteed by `vm_check_stack()`,
+ *  e.g. for error messages. Analogous to `EXTRA_STACK` in Lua 5.1.5. */
+static constexpr int STACK_EXTRA = 5;
+
+/** @brief Maximum number of stack slots in use at any one time. Analogous to
+ *  `LUAI_MAXSTACK` in Lua 5.4. */
+static constexpr int MAX_STACK = 1'000'000;
 
 struct Error_Handler {
     Error_Handler *prev; // Stack-allocated linked list.
+#if LULU_USE_LONGJMP
+    jmp_buf jump;
+#endif // LULU_USE_LONGJMP
     volatile Error error;
 };
 
@@ -23,6 +39,15 @@ struct Call_Frame {
     const Instruction *saved_ip;
     int                to_return;
 
+    // Replaced the frame of the function that tail called it, so the
+    // calling instruction in the parent frame does not describe it.
+    bool is_tail_call;
+
+    // A Lua metamethod or `for` generator called by the instruction at
+    // `saved_ip - 1` of the Lua frame below it, which `vm_execute()` must
+    // finish once this returns. See `vm_call_mt()`.
+    bool is_continuation;
+
     bool
     is_c() const noexcept
     {
@@ -51,10 +76,10 @@ struct Call_Frame {
 enum Call_Type {
     CALL_LUA,
     CALL_C,
+    CALL_YIELD, // A C function called `lulu_yield()`; see `vm_execute()`.
 };
 
-using Stack_Array = Array<Value, MAX_STACK>;
-using Frame_Array = Small_Array<Call_Frame, 16>;
+using Frame_Array = Dynamic<Call_Frame>;
 
 struct lulu_Global {
     lulu_CFunction panic_fn;
@@ -95,17 +120,42 @@ struct lulu_Global {
     // Can be modified in-place during trace phase.
     GC_List *gray_tail;
 
+    // The thread returned by `lulu_open()`. Unlike coroutines it is not in
+    // `objects`, as it lives exactly as long as the global state.
+    lulu_VM *main_thread;
+
+    // Maximum length of `lulu_VM::frames`; see `lulu_set_call_limit()`.
+    int max_calls;
+
+    // See `lulu_set_jit()`.
+    bool jit_enabled;
+
+    // See `lulu_set_budget()`. `budget_left` counts down on every call and
+    // backward jump, but only while `has_budget` is set.
+    lulu_Budget_Handler budget_handler;
+    void *budget_data;
+    int   budget_left;
+    bool  has_budget;
+
+#if LULU_AOT
+    // Handles of the shared libraries loaded by `lulu_load_aot()`.
+    Dynamic<void *> aot_libraries;
+#endif // LULU_AOT
+
     // Metatables for basic types.
-    Table   *mt_basic[VALUE_TYPE_LAST];
+    Table   *mt_basic[VALUE_TYPE_LAST + 1];
     OString *mt_names[MT_COUNT];
 
     GC_State gc_state;
 };
 
-struct LULU_PUBLIC lulu_VM {
+/** @brief A thread: the main one, or a coroutine. Coroutines are objects of
+ *  type `VALUE_THREAD`, each with its own stack and call frames.
+ */
+struct LULU_PUBLIC lulu_VM : Object_Header {
     lulu_Global       *G;
-    Stack_Array        stack;
-    Frame_Array        frames;
+    Slice<Value>       stack; // Heap-allocated; see `vm_check_stack()`.
+    Frame_Array        frames; // Heap-allocated; see `frame_push()`.
     Call_Frame        *caller; // Not a reference because it can be reassigned.
     Slice<Value>       window;
     Value              globals;
@@ -116,6 +166,32 @@ struct LULU_PUBLIC lulu_VM {
     // Helps with variable reuse.
     Object_List *open_upvalues;
 
+    // The open upvalue of each stack slot, if any, so that `upvalue_find()`
+    // need not walk `open_upvalues`. Resized along with `stack`, and never
+    // shorter than it.
+    Slice<Upvalue *> open_slots;
+
+    // Used only when this thread is gray.
+    GC_List *gc_list;
+
+    // `LULU_YIELD` when suspended, or the error that killed a coroutine.
+    Error status;
+
+    // Number of nested calls to `vm_call()`, which each recurse in C.
+    int n_ccalls;
+
+    // `n_ccalls` as of the last resume. Yielding is only possible when no
+    // C calls were made since.
+    int base_ccalls;
+
+    // Set by `vm_execute()` while running an instruction which it can finish
+    // after a Lua metamethod returns; see `vm_call_mt()`.
+    bool can_continue;
+
+    // The message of the error being thrown is still in `G->builder`, as
+    // written by `vm_runtime_error()`, rather than on the stack.
+    bool lazy_error;
+
     LULU_PRIVATE
     lulu_VM() = default;
 };
@@ -126,6 +202,13 @@ G(lulu_VM *L)
     return L->G;
 }
 
+inline lulu_VM *
+Value::to_thread() const
+{
+    lulu_assert(this->is_thread());
+    return reinterpret_cast<lulu_VM *>(this->to_object());
+}
+
 inline void
 gc_check(lulu_VM *L, lulu_Global *g)
 {
@@ -189,7 +272,8 @@ vm_save_top(lulu_VM *L)
  *
  * @details
  *  In case of errors, the stack frame before the call is restored and the error
- *  message, a string, pushed to the stack.
+ *  message, a string, pushed to the stack. Lazy error messages from
+ *  `vm_runtime_error()` become strings only here.
  */
 Error
 vm_pcall(lulu_VM *L, Protected_Fn fn, void *user_ptr);
@@ -221,6 +305,16 @@ vm_pop_value(lulu_VM *L)
     L->window.len -= 1;
 }
 
+/** @brief Ensures there are at least `n` free slots after the current top.
+ *
+ * @details
+ *  The stack is reallocated as needed, growing geometrically. All stack
+ *  windows and open upvalues are fixed up to point into the new stack.
+ *
+ * @warning(2025-09-17)
+ *  Any other `Value *` into the stack is invalidated; save its index with
+ *  `vm_save_index()` beforehand if it needs to be used afterwards.
+ */
 void
 vm_check_stack(lulu_VM *L, int n);
 
@@ -240,6 +334,41 @@ bool
 vm_to_number(const Value *v, Value *out);
 
 
+/** @brief `*r = a + b` for `a` and `b` in integer form.
+ *
+ * @return
+ *      true if `*r` is exact and thus can be stored in integer form too.
+ *      Otherwise the caller should compute the result as a `Number`.
+ */
+inline bool
+integer_add(Integer a, Integer b, Integer *r)
+{
+    *r = a + b;
+    return integer_is_exact(*r);
+}
+
+inline bool
+integer_sub(Integer a, Integer b, Integer *r)
+{
+    *r = a - b;
+    return integer_is_exact(*r);
+}
+
+inline bool
+integer_mul(Integer a, Integer b, Integer *r)
+{
+    // Operands of at most 26 bits cannot give a product over 52 bits, so
+    // we never have to worry about overflow.
+    constexpr Integer max = static_cast<Integer>(1) << 26;
+    if (-max <= a && a <= max && -max <= b && b <= max) {
+        *r = a * b;
+        // e.g. `0 * -1` is `-0` which has no integer form.
+        return *r != 0 || (a >= 0 && b >= 0);
+    }
+    return false;
+}
+
+
 /**
  * @param [in, out] v
  *      As input, holds the value we wish to convert, which is only valid
@@ -258,6 +387,14 @@ vm_push_fstring(lulu_VM *L, const char *fmt, ...);
 const char *
 vm_push_vfstring(lulu_VM *L, const char *fmt, va_list args);
 
+/** @brief Throws a runtime error, with the current line as the message
+ *  prefix.
+ *
+ * @details
+ *  The message is only written to the builder. It is interned when the
+ *  error is caught and its message kept, so an error which is caught by a
+ *  `pcall()` whose message is never used creates no string.
+ */
 [[noreturn, gnu::format(printf, 2, 3)]] void
 vm_runtime_error(lulu_VM *L, const char *fmt, ...);
 
@@ -303,10 +440,46 @@ vm_call_init(lulu_VM *L, const Value *ra, int argc, int to_return);
  *      simply pop the temporary call frame we used then.
  *
  *  3.) Otherwise, Lua calls return to `vm_execute()`.
+ *
+ * @note(2025-09-17)
+ *  The stack may be shrunk afterwards, which invalidates pointers into it
+ *  just like `vm_check_stack()` does.
  */
 void
 vm_call_fini(lulu_VM *L, Slice<Value> results);
 
+
+/** @brief Replaces the current Lua call frame with a call to the Lua
+ *  function at `ra`, for `OP_TAIL_CALL`.
+ *
+ * @details
+ *  The function and its arguments are moved down to the current function's
+ *  stack slot, so the stack window and frame count do not grow no matter how
+ *  many tail calls are made in a row. Results are later returned directly to
+ *  the original caller.
+ *
+ * @note(2025-09-16) Assumptions:
+ *
+ *  1.) The current frame is a Lua function whose upvalues were already
+ *      closed.
+ *
+ *  2.) `ra` is a Lua function. C functions are simply called normally.
+ */
+void
+vm_call_tail(lulu_VM *L, const Value *ra, int n_args);
+
+/** @brief Creates a coroutine sharing the globals of `L`, and pushes it to
+ *  the stack of `L` so that it is not collected right away.
+ *
+ * @note(2025-09-18)
+ *  Analogous to `lstate.c:luaE_newthread()` in Lua 5.1.5.
+ */
+lulu_VM *
+thread_new(lulu_VM *L);
+
+void
+thread_free(lulu_VM *L, lulu_VM *co);
+
 Error
 vm_load(lulu_VM *L, LString source, Stream *z);
 
@@ -318,3 +491,39 @@ vm_table_set(lulu_VM *L, const Value *t, const Value *k, Value v);
 
 void
 vm_execute(lulu_VM *L, int n_calls);
+
+// The generators of `next()`, `ipairs()` and `range()` in `lib_base.cpp`.
+// `OP_FOR_IN` recognizes them so it can run them without a call.
+int
+base_next(lulu_VM *L);
+
+int
+ipairs_next(lulu_VM *L);
+
+int
+range_iterator(lulu_VM *L);
+
+// `pcall()` in `lib_base.cpp`. `OP_CALL` recognizes it so it can skip the
+// error message when only the status is used.
+int
+base_pcall(lulu_VM *L);
+
+// The `math` functions in `lib_math.cpp` which `OP_CALL_MATH` recognizes so
+// it can run them without a call.
+int
+math_abs(lulu_VM *L);
+
+int
+math_ceil(lulu_VM *L);
+
+int
+math_floor(lulu_VM *L);
+
+int
+math_max(lulu_VM *L);
+
+int
+math_min(lulu_VM *L);
+
+int
+math_sqrt(lulu_VM *L);
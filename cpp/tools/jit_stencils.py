@@ -0,0 +1,540 @@
+"""
+Generates `src/jit_stencils.hpp`, the machine code templates ('stencils') used
+by the copy-and-patch compiler in `src/jit.cpp`.
+
+Each stencil is assembled on its own with the GNU assembler. Its operands are
+left as undefined symbols, so the assembler emits relocations for them. Those
+relocations are exactly the 'holes' that `jit.cpp` patches after copying the
+stencil. Run this from anywhere after editing a stencil:
+
+    python3 cpp/tools/jit_stencils.py
+
+Register conventions, see `Jit_Function` in `src/jit.hpp`:
+    rdi     Base of the register window, i.e. `&R(0)`.
+    rsi     Native address to start at. Only used by `entry`.
+    rdx     `Closure_Lua::upvalues` of the running closure. `mod` needs it
+            for `idiv`, so it saves it in r11 meanwhile.
+    r8, r9  Pointers to the left and right operands, set by the `load_*`
+            stencils.
+    al      Result of a test or comparison, consumed by the `branch_*` and
+            `skip_*` stencils.
+
+Everything else used (rax, rcx, r10, r11, xmm0-xmm3) is scratch. Stencils
+never call anything nor touch the machine stack, so there is nothing to save.
+"""
+import os
+import subprocess
+import tempfile
+from typing import Final
+
+# Must match `Value_Type` in `src/private.hpp`; checked by `src/jit.cpp`.
+TAG_NIL:     Final = 0
+TAG_BOOLEAN: Final = 1
+TAG_NUMBER:  Final = 3
+TAG_TABLE:   Final = 5
+TAG_INTEGER: Final = 11
+
+# Symbols which may be used as holes, in the order of `Jit_Hole_Kind`.
+HOLES: Final = [
+    "ra",              # Byte offset of R(A) from rdi.
+    "operand",         # Byte offset of R(B) from rdi, or address of a K(B).
+    "index",           # Some immediate value, e.g. a pc.
+    "upvalue_value",   # offsetof(Upvalue, value)
+    "table_array",     # offsetof(Table, array.data)
+    "table_length",    # offsetof(Table, array.len)
+    "table_metatable", # offsetof(Table, metatable)
+    "exit",            # Returns this instruction's pc to the interpreter.
+    "target",          # Native code for the jump target.
+    "skip",            # Native code for the instruction after the next.
+]
+
+# Loads the number at [ptr] into xmm, or exits if it is not a number.
+def load_number(ptr: str, xmm: str) -> str:
+    return f"""
+    cmp byte ptr [{ptr}], {TAG_NUMBER}
+    jne 1f
+    movsd {xmm}, qword ptr [{ptr} + 8]
+    jmp 2f
+1:
+    cmp byte ptr [{ptr}], {TAG_INTEGER}
+    jne exit
+    cvtsi2sd {xmm}, qword ptr [{ptr} + 8]
+2:
+"""
+
+# Loads the integral value of the number at [ptr] into reg, or exits if it is
+# not a number or has no exact integer value. Uses rax and xmm3.
+def load_integral(ptr: str, reg: str) -> str:
+    return f"""
+    mov {reg}, qword ptr [{ptr} + 8]
+    cmp byte ptr [{ptr}], {TAG_INTEGER}
+    je 2f
+    cmp byte ptr [{ptr}], {TAG_NUMBER}
+    jne exit
+    movsd xmm3, qword ptr [{ptr} + 8]
+    cvttsd2si {reg}, xmm3
+    movabs rax, 0x20000000000000
+    add rax, {reg}
+    shr rax, 54
+    jnz exit
+    cvtsi2sd xmm2, {reg}
+    ucomisd xmm2, xmm3
+    jne exit
+    jp exit
+2:
+"""
+
+# R(A) := [r8] op [r9]. `int_body` finds the result of two operands in integer
+# form: it starts with the left one in rax, and leaves the result there or
+# jumps to 3f if it is not exact.
+def arith(int_body: str, number_op: str) -> str:
+    int_path = "" if not int_body else f"""
+    cmp byte ptr [r8], {TAG_INTEGER}
+    jne 3f
+    cmp byte ptr [r9], {TAG_INTEGER}
+    jne 3f
+    mov rax, qword ptr [r8 + 8]
+{int_body}
+    mov byte ptr [rdi + ra], {TAG_INTEGER}
+    mov qword ptr [rdi + ra + 8], rax
+    jmp 4f
+"""
+    return f"""
+{int_path}
+3:
+{load_number("r8", "xmm0")}
+{load_number("r9", "xmm1")}
+    {number_op} xmm0, xmm1
+    mov byte ptr [rdi + ra], {TAG_NUMBER}
+    movsd qword ptr [rdi + ra + 8], xmm0
+4:
+"""
+
+# |rax| <= 2^53, see `integer_is_exact()`.
+EXACT_CHECK: Final = """
+    movabs rcx, 0x20000000000000
+    add rcx, rax
+    movabs r10, 0x40000000000000
+    cmp rcx, r10
+    ja 3f
+"""
+
+# al := [r8] < [r9] or [r8] <= [r9], for numbers only.
+def compare(int_set: str, number_set: str) -> str:
+    return f"""
+    cmp byte ptr [r8], {TAG_INTEGER}
+    jne 3f
+    cmp byte ptr [r9], {TAG_INTEGER}
+    jne 3f
+    mov rax, qword ptr [r8 + 8]
+    cmp rax, qword ptr [r9 + 8]
+    {int_set} al
+    jmp 4f
+3:
+{load_number("r8", "xmm0")}
+{load_number("r9", "xmm1")}
+    ucomisd xmm1, xmm0
+    {number_set} al
+4:
+"""
+
+# eax := 1 if [r8] is truthy else 0.
+TRUTHY: Final = f"""
+    movzx eax, byte ptr [r8]
+    cmp eax, {TAG_BOOLEAN}
+    ja 1f
+    jb 2f
+    movzx eax, byte ptr [r8 + 8]
+    test eax, eax
+    setnz al
+    jmp 3f
+1:
+    mov eax, 1
+    jmp 3f
+2:
+    xor eax, eax
+3:
+"""
+
+# Finds the array slot for the key at [r8] of the table at [rax] in rcx, or
+# exits if there is none or if it is `nil` and may have `__index` or
+# `__newindex`.
+ARRAY_SLOT: Final = f"""
+    cmp byte ptr [r8], {TAG_INTEGER}
+    jne exit
+    mov rcx, qword ptr [r8 + 8]
+    sub rcx, 1
+    cmp rcx, qword ptr [rax + table_length]
+    jae exit
+    shl rcx, 4
+    add rcx, qword ptr [rax + table_array]
+    cmp byte ptr [rcx], {TAG_NIL}
+    jne 5f
+    cmp qword ptr [rax + table_metatable], 0
+    jne exit
+5:
+"""
+
+STENCILS: Final = {
+    # Jumps to the native code for the pc the interpreter was at.
+    "entry": """
+    jmp rsi
+""",
+    # Returns control to the interpreter at `index`.
+    "exit": """
+    mov eax, offset index
+    ret
+""",
+    "load_left_reg": """
+    lea r8, [rdi + operand]
+""",
+    "load_left_k": """
+    movabs r8, offset operand
+""",
+    "load_right_reg": """
+    lea r9, [rdi + operand]
+""",
+    "load_right_k": """
+    movabs r9, offset operand
+""",
+    "load_left_upvalue": """
+    mov r8, qword ptr [rdx + index]
+    mov r8, qword ptr [r8 + upvalue_value]
+""",
+    "move": """
+    movups xmm0, xmmword ptr [r8]
+    movups xmmword ptr [rdi + ra], xmm0
+""",
+    "set_upvalue": """
+    mov rax, qword ptr [rdx + index]
+    mov rax, qword ptr [rax + upvalue_value]
+    movups xmm0, xmmword ptr [rdi + ra]
+    movups xmmword ptr [rax], xmm0
+""",
+    "nil": """
+    xorps xmm0, xmm0
+    movups xmmword ptr [rdi + ra], xmm0
+""",
+    "bool": f"""
+    mov qword ptr [rdi + ra + 8], offset index
+    mov byte ptr [rdi + ra], {TAG_BOOLEAN}
+""",
+    "jump": """
+    jmp target
+""",
+    "add": arith("""
+    add rax, qword ptr [r9 + 8]
+""" + EXACT_CHECK, "addsd"),
+    "sub": arith("""
+    sub rax, qword ptr [r9 + 8]
+""" + EXACT_CHECK, "subsd"),
+    # See `integer_mul()`.
+    "mul": arith("""
+    mov rcx, qword ptr [r9 + 8]
+    lea r10, [rax + 0x4000000]
+    cmp r10, 0x8000000
+    ja 3f
+    lea r10, [rcx + 0x4000000]
+    cmp r10, 0x8000000
+    ja 3f
+    mov r10, rax
+    or r10, rcx
+    imul rax, rcx
+    test rax, rax
+    jnz 5f
+    test r10, r10
+    js 3f
+5:
+""", "mulsd"),
+    "div": arith("", "divsd"),
+    # `fmod()` of integral operands is their remainder, except that it is
+    # `-0` when a negative dividend is divisible and NaN when dividing by 0.
+    # Those are left to the interpreter along with all other numbers. The sign
+    # bit of a negative dividend is set in either form. The result is always
+    # in number form, as in the interpreter.
+    "mod": f"""
+{load_integral("r9", "rcx")}
+    test rcx, rcx
+    jz exit
+{load_integral("r8", "r10")}
+    mov r11, rdx
+    mov rax, r10
+    cqo
+    idiv rcx
+    mov rax, rdx
+    mov rdx, r11
+    test rax, rax
+    jnz 1f
+    cmp qword ptr [r8 + 8], 0
+    jl exit
+1:
+    cvtsi2sd xmm0, rax
+    mov byte ptr [rdi + ra], {TAG_NUMBER}
+    movsd qword ptr [rdi + ra + 8], xmm0
+""",
+    "unm": f"""
+{load_number("r8", "xmm0")}
+    movabs rax, 0x8000000000000000
+    movq xmm1, rax
+    xorpd xmm0, xmm1
+    mov byte ptr [rdi + ra], {TAG_NUMBER}
+    movsd qword ptr [rdi + ra + 8], xmm0
+""",
+    "not": f"""
+{TRUTHY}
+    xor eax, 1
+    mov qword ptr [rdi + ra + 8], rax
+    mov byte ptr [rdi + ra], {TAG_BOOLEAN}
+""",
+    "truthy": TRUTHY,
+    # Raw equality, exactly as `Value::operator==`.
+    "eq": f"""
+    movzx eax, byte ptr [r8]
+    movzx ecx, byte ptr [r9]
+    cmp eax, ecx
+    jne 5f
+    cmp eax, {TAG_NUMBER}
+    je 6f
+    cmp eax, {TAG_BOOLEAN}
+    ja 7f
+    je 8f
+    mov eax, 1
+    jmp 4f
+7:
+    mov rax, qword ptr [r8 + 8]
+    cmp rax, qword ptr [r9 + 8]
+    sete al
+    jmp 4f
+8:
+    mov al, byte ptr [r8 + 8]
+    cmp al, byte ptr [r9 + 8]
+    sete al
+    jmp 4f
+5:
+    cmp eax, {TAG_NUMBER}
+    je 9f
+    cmp eax, {TAG_INTEGER}
+    jne 10f
+    cmp ecx, {TAG_NUMBER}
+    jne 10f
+    cvtsi2sd xmm0, qword ptr [r8 + 8]
+    movsd xmm1, qword ptr [r9 + 8]
+    jmp 11f
+9:
+    cmp ecx, {TAG_INTEGER}
+    jne 10f
+    movsd xmm0, qword ptr [r8 + 8]
+    cvtsi2sd xmm1, qword ptr [r9 + 8]
+    jmp 11f
+6:
+    movsd xmm0, qword ptr [r8 + 8]
+    movsd xmm1, qword ptr [r9 + 8]
+11:
+    ucomisd xmm0, xmm1
+    sete al
+    setnp cl
+    and al, cl
+    jmp 4f
+10:
+    xor eax, eax
+4:
+""",
+    "lt": compare("setl", "seta"),
+    "leq": compare("setle", "setae"),
+    "branch_true": """
+    test al, al
+    jnz target
+    jmp skip
+""",
+    "branch_false": """
+    test al, al
+    jz target
+    jmp skip
+""",
+    "skip_true": """
+    test al, al
+    jnz skip
+""",
+    "skip_false": """
+    test al, al
+    jz skip
+""",
+    # r8 is &R(A); see `OP_FOR_LOOP` in `vm_execute()`. When the index is in
+    # integer form, so are the limit and increment. Otherwise any of them
+    # may be in either form.
+    "for_loop": f"""
+    cmp byte ptr [r8], {TAG_INTEGER}
+    jne 5f
+    mov rax, qword ptr [r8 + 8]
+    mov rcx, qword ptr [r8 + 40]
+    add rax, rcx
+    test rcx, rcx
+    jle 1f
+    cmp rax, qword ptr [r8 + 24]
+    jg 4f
+    jmp 2f
+1:
+    cmp rax, qword ptr [r8 + 24]
+    jl 4f
+2:
+    mov qword ptr [r8 + 8], rax
+    mov byte ptr [r8 + 48], {TAG_INTEGER}
+    mov qword ptr [r8 + 56], rax
+    jmp target
+5:
+{load_number("r8 + 32", "xmm2")}
+{load_number("r8 + 16", "xmm3")}
+    movsd xmm0, qword ptr [r8 + 8]
+    addsd xmm0, xmm2
+    xorpd xmm1, xmm1
+    ucomisd xmm2, xmm1
+    ja 1f
+    ucomisd xmm0, xmm3
+    jae 2f
+    jmp 4f
+1:
+    ucomisd xmm3, xmm0
+    jae 2f
+    jmp 4f
+2:
+    movsd qword ptr [r8 + 8], xmm0
+    mov byte ptr [r8 + 48], {TAG_NUMBER}
+    movsd qword ptr [r8 + 56], xmm0
+    jmp target
+4:
+""",
+    # R(A) := [r9][[r8]]
+    "get_table_int": f"""
+    cmp byte ptr [r9], {TAG_TABLE}
+    jne exit
+    mov rax, qword ptr [r9 + 8]
+{ARRAY_SLOT}
+    movups xmm0, xmmword ptr [rcx]
+    movups xmmword ptr [rdi + ra], xmm0
+""",
+    # R(A)[[r8]] := [r9]
+    "set_table_int": f"""
+    cmp byte ptr [rdi + ra], {TAG_TABLE}
+    jne exit
+    mov rax, qword ptr [rdi + ra + 8]
+{ARRAY_SLOT}
+    movups xmm0, xmmword ptr [r9]
+    movups xmmword ptr [rcx], xmm0
+""",
+}
+
+Hole = tuple[int, str, int, int] # offset, symbol, size, addend
+
+RELOCATION_SIZES: Final = {
+    "R_X86_64_32":    4,
+    "R_X86_64_32S":   4,
+    "R_X86_64_64":    8,
+    "R_X86_64_PC32":  4,
+    "R_X86_64_PLT32": 4,
+}
+
+def assemble(name: str, source: str, tmp: str) -> tuple[bytes, list[Hole]]:
+    s_path = os.path.join(tmp, name + ".s")
+    o_path = os.path.join(tmp, name + ".o")
+    b_path = os.path.join(tmp, name + ".bin")
+    with open(s_path, "w") as f:
+        f.write(".intel_syntax noprefix\n.text\n" + source)
+
+    subprocess.run(["as", "--64", "-o", o_path, s_path], check=True)
+    subprocess.run(["objcopy", "-O", "binary", "-j", ".text", o_path, b_path],
+                   check=True)
+    with open(b_path, "rb") as f:
+        code = f.read()
+
+    out = subprocess.run(["readelf", "-rW", o_path], check=True,
+                         capture_output=True, text=True).stdout
+    holes: list[Hole] = []
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) < 5 or fields[2] not in RELOCATION_SIZES:
+            continue
+        offset = int(fields[0], 16)
+        symbol = fields[4]
+        addend = int(fields[5] + fields[6], 16) if len(fields) >= 7 else 0
+        if symbol not in HOLES:
+            raise ValueError(f"{name}: unknown hole '{symbol}'")
+        holes.append((offset, symbol, RELOCATION_SIZES[fields[2]], addend))
+    holes.sort()
+    return code, holes
+
+def main():
+    here   = os.path.dirname(os.path.abspath(__file__))
+    output = os.path.join(here, "..", "src", "jit_stencils.hpp")
+
+    lines = [
+        "// Generated by `tools/jit_stencils.py`. Do not edit by hand!",
+        "#pragma once",
+        "",
+        '#include "private.hpp"',
+        "",
+        "enum Jit_Hole_Kind : u8 {",
+    ]
+    lines += [f"    JIT_HOLE_{h.upper()}," for h in HOLES]
+    lines += [
+        "};",
+        "",
+        "struct Jit_Hole {",
+        "    u16           offset;",
+        "    Jit_Hole_Kind kind;",
+        "    u8            size; // In bytes.",
+        "    i32           addend;",
+        "};",
+        "",
+        "struct Jit_Stencil {",
+        "    const u8       *code;",
+        "    isize           size;",
+        "    const Jit_Hole *holes;",
+        "    isize           n_holes;",
+        "};",
+        "",
+        "enum Jit_Stencil_Id : u8 {",
+    ]
+    lines += [f"    STENCIL_{name.upper()}," for name in STENCILS]
+    lines += ["};", ""]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        has_holes: set[str] = set()
+        for name, source in STENCILS.items():
+            code, holes = assemble(name, source, tmp)
+            lines.append(f"static const u8 stencil_{name}_code[] = {{")
+            for i in range(0, len(code), 12):
+                row = ", ".join(f"0x{b:02x}" for b in code[i:i + 12])
+                lines.append(f"    {row},")
+            lines.append("};")
+            lines.append("")
+            if not holes:
+                continue
+            has_holes.add(name)
+            lines.append(f"static const Jit_Hole stencil_{name}_holes[] = {{")
+            for offset, symbol, size, addend in holes:
+                kind = f"JIT_HOLE_{symbol.upper()}"
+                lines.append(f"    {{{offset}, {kind}, {size}, {addend}}},")
+            lines.append("};")
+            lines.append("")
+
+    # Indexed by `Jit_Stencil_Id`.
+    lines.append("static const Jit_Stencil jit_stencils[] = {")
+    for name in STENCILS:
+        code = f"stencil_{name}_code"
+        lines.append(f"    {{{code}, count_of({code}),")
+        if name in has_holes:
+            holes = f"stencil_{name}_holes"
+            entry = f"     {holes}, count_of({holes})}},"
+            if len(entry) > 80:
+                entry = f"     {holes},\n     count_of({holes})}},"
+            lines.append(entry)
+        else:
+            lines.append("     nullptr, 0},")
+    lines.append("};")
+    lines.append("")
+
+    with open(output, "w") as f:
+        f.write("\n".join(lines))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,62 @@
+-- Run by `task cpp:test-aot`, which compiles this script ahead of time and
+-- checks that the native results are the same as the interpreted ones. It
+-- then changes an operator in `sums()` in a copy of this script, which must
+-- no longer match the code in the library and so is interpreted instead.
+local N = 1000
+
+local function sums(step)
+    local x, y = 0, 0.5
+    for i = 1, N do
+        x = x + i * step - 1
+        y = y + i / 4
+    end
+    return x, y, x % 7, -x, 2^10
+end
+
+local function compare(a, b)
+    return (a < b and "<" or "") .. (a <= b and "=" or "")
+        .. (a == b and "e" or "") .. (not (a < b) and "!" or "")
+end
+
+local function counter()
+    local count = 0
+    return function(n)
+        for _ = 1, n do
+            count = count + 1
+        end
+        return count
+    end
+end
+
+local function arrays(t, n)
+    local s = 0
+    for i = 1, n do
+        t[i] = i * 2
+    end
+    for i = 1, n + 5 do
+        local v = t[i]
+        if v then s = s + v end
+    end
+    return s, t[1], t[n], t[n + 1]
+end
+
+local STEP = 3
+print(sums(STEP))
+print(sums(0.25))
+print(compare(1, 2), compare(2, 2.0), compare(0/0, 1), compare(STEP, 2))
+
+local c1, c2 = counter(), counter()
+print(c1(N), c2(5), c1(STEP))
+print(arrays({}, N))
+
+-- Operands of the wrong type are left to the interpreter.
+local V = {__mul = function(a, b) return 1 end}
+print(sums(setmetatable({}, V)))
+print(sums("2"))
+print(pcall(sums, "x"))
+
+local total = 0
+for i = 1, N, STEP do
+    total = total + i
+end
+print(total)
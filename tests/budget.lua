@@ -0,0 +1,78 @@
+-- Run with `LULU_BUDGET=10000`, which is far less than any of these loops
+-- need, so each of them must be stopped with an error. The standalone
+-- interpreter allows the whole budget again once the error is caught.
+local N = 1e6
+
+local function stopped(name, fn, arg)
+    local ok, msg = pcall(fn, arg)
+    assert(not ok, name .. " was not stopped")
+    assert(string.find(msg, "Instruction budget exceeded"), msg)
+    print(name, "stopped")
+end
+
+stopped("while", function()
+    local i = 0
+    while i < N do
+        i = i + 1
+    end
+end)
+
+stopped("numeric for", function()
+    local x = 0
+    for i = 1, N do
+        x = x + i
+    end
+end)
+
+stopped("repeat", function()
+    local i = 0
+    repeat
+        i = i + 1
+    until i >= N
+end)
+
+local function depth(n)
+    if n == 0 then
+        return 0
+    end
+    return depth(n - 1) + 1
+end
+stopped("recursion", depth, 15000)
+
+local function tail(n)
+    if n == 0 then
+        return "done"
+    end
+    return tail(n - 1)
+end
+stopped("tail calls", tail, N)
+
+-- Lua and C generators, i.e. calls made by `OP_FOR_IN` itself.
+local function count(_, i)
+    if i < N then
+        return i + 1
+    end
+end
+stopped("generic for", function()
+    for _ in count, nil, 0 do end
+end)
+stopped("C generator", function()
+    local i = 0
+    local gen = coroutine.wrap(function()
+        while true do coroutine.yield(i) end
+    end)
+    for _ in gen do
+        i = i + 1
+        if i >= N then break end
+    end
+end)
+
+-- The jump after a comparison that called a Lua metamethod.
+local calls = 0
+local o = setmetatable({}, {__lt = function(a, b)
+    calls = calls + 1
+    return calls >= N
+end})
+stopped("metamethod", function()
+    repeat until o < o
+end)
@@ -2,3 +2,12 @@
 print("hi" .. ' ' .. "mom!" == "hi mom!")
 print("hi" .. ' ' .. "mom!" == "hi" .. " mom!")
 print("hi" .. ' ' .. "mom" .. '!' == "hi" .. ' ' .. "mom" .. '!')
+
+-- Numbers are formatted in place; results are still interned.
+local id, n = 42, 1.5
+local key = "user:" .. id .. ":" .. n
+print(key == "user:42:1.5")
+local t = {["user:42:1.5"] = 1}
+print(t[key] == 1)
+print(1 .. 2 == "12", "" .. "" == "", -0.25 .. "" == "-0.25")
+print(not pcall(function() return "a" .. {} end))
@@ -0,0 +1,148 @@
+-- Generators: values flow out through `yield`, and back in through `resume`.
+local function range_gen(n)
+    return coroutine.wrap(function()
+        for i = 1, n do
+            coroutine.yield(i)
+        end
+    end)
+end
+
+local sum = 0
+for i in range_gen(100) do
+    sum = sum + i
+end
+print(sum)
+
+local co = coroutine.create(function(a, b)
+    print("start", a, b)
+    local c = coroutine.yield(a + b)
+    print("got", c)
+    local d, e = coroutine.yield(c * 2)
+    print("got", d, e)
+    return "done", d + e
+end)
+
+print(coroutine.status(co))
+print(coroutine.resume(co, 1, 2))
+print(coroutine.status(co))
+print(coroutine.resume(co, 10))
+print(coroutine.resume(co, 3, 4))
+print(coroutine.status(co))
+print(coroutine.resume(co))
+
+-- Producer/consumer, each with its own locals and call depth.
+local function producer()
+    return coroutine.create(function()
+        local words = {"alpha", "beta", "gamma"}
+        for i = 1, #words do
+            coroutine.yield(words[i])
+        end
+        return nil
+    end)
+end
+
+local function consume(p)
+    local out = {}
+    while true do
+        local ok, w = coroutine.resume(p)
+        if not w then
+            break
+        end
+        out[#out + 1] = string.upper(w)
+    end
+    return table.concat(out, " ")
+end
+print(consume(producer()))
+
+-- Yielding from nested Lua calls inside the coroutine.
+local function walk(t, depth)
+    for i = 1, #t do
+        if type(t[i]) == "table" then
+            walk(t[i], depth + 1)
+        else
+            coroutine.yield(t[i], depth)
+        end
+    end
+end
+
+local tree = {1, {2, {3, 4}}, 5}
+for v, depth in coroutine.wrap(function() walk(tree, 0) end) do
+    print(v, depth)
+end
+
+-- Errors kill the coroutine, and are returned by `resume`.
+local bad = coroutine.create(function()
+    coroutine.yield(1)
+    local t = nil
+    return t.x
+end)
+print(coroutine.resume(bad))
+print(coroutine.resume(bad))
+print(coroutine.status(bad))
+print(coroutine.resume(bad))
+
+-- `error()` called from the main function of a coroutine still reports where.
+print(coroutine.resume(coroutine.create(function()
+    error("from the body")
+end)))
+print(coroutine.resume(coroutine.create(function()
+    local function f() error("from a nested call") end
+    f()
+end)))
+
+-- Lua metamethods run in frames of their own, so they can be suspended like
+-- any other Lua function. Functions called by `pcall` are called from C,
+-- which cannot.
+local mt = {__index = function(t, k) return coroutine.yield(k) end}
+local across = coroutine.create(function()
+    local t = setmetatable({}, mt)
+    local v = t.x
+    print("resumed with", v)
+    return pcall(coroutine.yield)
+end)
+print(coroutine.resume(across))
+print(coroutine.resume(across, 42))
+
+-- Statuses as seen from inside.
+local outer
+outer = coroutine.create(function()
+    print("outer", coroutine.status(outer), coroutine.running() == outer)
+    local inner = coroutine.create(function()
+        print("inner sees outer as", coroutine.status(outer))
+    end)
+    coroutine.resume(inner)
+    print("inner", coroutine.status(inner))
+end)
+coroutine.resume(outer)
+print(coroutine.running())
+print(coroutine.resume(outer))
+print(type(outer))
+
+-- Upvalues shared with a coroutine stay valid after it is abandoned.
+local getters = {}
+for i = 1, 200 do
+    local c = coroutine.create(function()
+        local x = i
+        getters[i] = function() return x end
+        coroutine.yield()
+    end)
+    coroutine.resume(c)
+end
+-- Enough garbage to run the GC, which sweeps the abandoned coroutines.
+for i = 1, 2000 do
+    local s = tostring(i)
+    local t = {i, s}
+end
+local total = 0
+for i = 1, #getters do
+    total = total + getters[i]()
+end
+print(total)
+
+-- Many short-lived coroutines.
+local n = 0
+for i = 1, 2000 do
+    local gen = range_gen(3)
+    n = n + gen() + gen() + gen()
+end
+print(n)
@@ -0,0 +1,5 @@
+-- Not a tail call, so this eventually runs out of call frames.
+local function f(n)
+    return 1 + f(n + 1)
+end
+f(1)
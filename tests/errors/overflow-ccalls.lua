@@ -0,0 +1,6 @@
+-- Each `pcall` recurses in C, so this hits the much lower limit.
+local function f()
+    local ok, err = pcall(f)
+    error(err, 0)
+end
+f()
@@ -0,0 +1,7 @@
+-- Errors from light C functions still name them and their caller's line.
+local function f(s)
+    local r = string.rep(s)
+    return r
+end
+print(string.rep("a", 2))
+print(f("b"))
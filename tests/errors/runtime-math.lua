@@ -0,0 +1,4 @@
+-- `math.max()` is run inline only when all of its arguments are numbers, so
+-- the error must still name the bad argument.
+print(math.max(1, 2, 3))
+print(math.max(1, 2, {}))
@@ -0,0 +1,4 @@
+-- Only coroutines can be suspended.
+local x = 1
+coroutine.yield(x)
+print("unreachable")
@@ -13,3 +13,36 @@ _G[2] = "mom"
 for i, v in lua_ipairs(_G) do
     print(i, v)
 end
+
+-- The built-in generators run without a call, so check that they still agree
+-- with calling them directly.
+local t = {10, 20, 30, x = "x"}
+local n = 0
+for k, v in pairs(t) do n = n + 1; assert(t[k] == v) end
+print("pairs", n)
+
+local k, v = next(t)
+for k2, v2, extra in next, t do
+    assert(k2 == k and v2 == v and extra == nil)
+    k, v = next(t, k)
+end
+print("next", k, v)
+
+for i, v, extra in ipairs({1, 2, nil, 4}) do print("ipairs", i, v, extra) end
+for i, v in ipairs({}) do print("empty", i, v) end
+for i in ipairs({1.5, "a", false, 3}) do print("ipairs false", i) end
+
+-- Holes can still be filled in by `__index`.
+local proxy = setmetatable({1, 2}, {__index = {nil, nil, 30, 40}})
+for i, v in ipairs(proxy) do print("proxy", i, v) end
+
+-- The loop can change the control variable's table as it goes.
+local grow = {1}
+for i, v in ipairs(grow) do
+    if i < 5 then grow[i + 1] = v * 2 end
+end
+print("grow", #grow, grow[5])
+
+for i in range(3) do print("range", i) end
+for i, extra in range(5, 0, -2.5) do print("range", i, extra) end
+for i in range(0, 1, 0.25) do print("range", i) end
@@ -0,0 +1,46 @@
+-- Closures which would capture the same upvalues as the last one created from
+-- the same function are reused; any others must still be distinct.
+local fs = {}
+for i = 1, 3 do
+    fs[i] = function(a, b) return a < b end
+end
+print("no upvalues", fs[1] == fs[2], fs[2] == fs[3], fs[1](1, 2))
+
+-- Each iteration has its own `i`, so each closure is different.
+for i = 1, 3 do
+    fs[i] = function() return i end
+end
+print("loop local", fs[1] == fs[2], fs[1](), fs[2](), fs[3]())
+
+-- The same open upvalue.
+local shared = 0
+local function make() return function() shared = shared + 1; return shared end end
+local a, b = make(), make()
+print("shared", a == b, a(), b())
+
+-- Upvalues of the enclosing function.
+local function counter()
+    local n = 0
+    local function get() return function() n = n + 1; return n end end
+    return get(), get()
+end
+local c1, c2 = counter()
+local c3 = counter()
+print("enclosing", c1 == c2, c1 == c3, c1(), c2(), c3())
+
+-- Once the upvalue is closed, a new closure gets a new upvalue.
+local function outer()
+    local x = 0
+    return function() x = x + 1; return x end
+end
+local o1, o2 = outer(), outer()
+print("closed", o1 == o2, o1(), o1(), o2())
+
+-- A cached closure which is no longer referenced can still be collected, and
+-- another one created in its place.
+for _ = 1, 3 do
+    local t = {}
+    for i = 1, 1000 do t[i] = {i} end
+    fs[1] = function(x) return x end
+end
+print("collected", fs[1](7))
@@ -0,0 +1,47 @@
+-- None of these are tail calls, so each level needs its own call frame.
+local function sum(n)
+    if n == 0 then
+        return 0
+    end
+    return n + sum(n - 1)
+end
+print(sum(10000))
+
+-- Recursive tree walks.
+local function build(depth)
+    if depth == 0 then
+        return nil
+    end
+    return {left = build(depth - 1), right = build(depth - 1)}
+end
+
+local function count(node)
+    if node == nil then
+        return 0
+    end
+    return 1 + count(node.left) + count(node.right)
+end
+print(count(build(12)))
+
+local list = nil
+for i = 1, 5000 do
+    list = {value = i, next = list}
+end
+
+local function length(node)
+    if node == nil then
+        return 0
+    end
+    return 1 + length(node.next)
+end
+print(length(list))
+
+-- Each metamethod call also recurses in C, which is limited separately.
+local mt = {}
+function mt.__index(t, k)
+    if k == 0 then
+        return 0
+    end
+    return t[k - 1] + 1
+end
+print(setmetatable({}, mt)[150])
@@ -0,0 +1,25 @@
+-- `type()`, `rawget()`, `string.len()` and friends are light C functions,
+-- whose results are moved straight into the caller's registers.
+local t = setmetatable({x = 1}, {__index = function() return "index" end})
+print(type(1), type("a"), type(t), type(nil), type(print))
+print(rawget(t, "x"), rawget(t, "y"), t.y, string.len("hello"), ("abc"):upper())
+
+-- Results are adjusted like any other call's.
+local a, b, c = type(1)
+print(a, b, c)
+local n = rawget({7}, 1) + string.len("abcd")
+print(n, (string.sub("hello", 2, 3)), string.rep("ab", 3, ","))
+
+-- Variadic arguments and results take the usual path in only one direction.
+local function two() return "x", 2 end
+print(type(two()), string.rep(two()), rawget({x = 9}, two()))
+print(string.sub("hello", 2))
+local u = {tonumber("10"), tonumber("ff", 16), tonumber("z"), 0}
+print(u[1], u[2], u[3], u[4])
+
+-- Many calls in a row, which must not leak stack slots.
+local s = 0
+for i = 1, 1000 do
+    s = s + string.len(string.rep("a", i % 10)) + tonumber(tostring(i))
+end
+print(s, setmetatable(t, nil) == t, getmetatable(t), next({}))
@@ -0,0 +1,37 @@
+-- Each of these needs far more stack slots than the stack starts out with,
+-- so it must be reallocated while the callers' frames are still active.
+local s = string.rep("a", 5000)
+
+local function bytes(i, j)
+    return string.byte(s, i, j)
+end
+
+local t = {bytes(1, -1)}
+print(#t, t[1], t[5000])
+
+-- Open upvalues must point into the new stack after it is reallocated.
+local function capture()
+    local x = 1
+    local function get() return x end
+    local u = {string.byte(s, 1, -1)}
+    x = #u
+    return get()
+end
+print(capture())
+
+-- Deep recursion where every frame holds on to a table constructor's worth
+-- of registers.
+local function nest(n)
+    if n == 0 then
+        return 0
+    end
+    local a, b, c, d, e, f, g, h = 1, 2, 3, 4, 5, 6, 7, 8
+    return (a + b + c + d + e + f + g + h) + nest(n - 1)
+end
+print(nest(12))
+
+-- After shrinking back down, the stack is still usable.
+for _ = 1, 3 do
+    local u = {bytes(1, 2000)}
+    print(#u, capture())
+end
@@ -0,0 +1,52 @@
+-- `return f(...)` replaces the current call frame, so none of these should
+-- overflow the call frame stack no matter how many calls are made.
+local function count(n, acc)
+    if n == 0 then
+        return acc
+    end
+    return count(n - 1, acc + 1)
+end
+print(count(100000, 0))
+
+local is_even, is_odd
+function is_even(n)
+    if n == 0 then return true end
+    return is_odd(n - 1)
+end
+function is_odd(n)
+    if n == 0 then return false end
+    return is_even(n - 1)
+end
+print(is_even(10001), is_odd(10001))
+
+-- Fewer and more arguments than parameters, and multiple results.
+local function pair(a, b) return a, b end
+local function fewer(x) return pair(x) end
+local function more(x) return pair(x, x + 1, x + 2) end
+print(fewer(1))
+print(more(1))
+
+-- Results of the previous variadic call are passed along as arguments.
+local function spread(n) return pair(pair(n, n * 2)) end
+print(spread(3))
+
+-- Only the results of the call itself are returned, not our locals.
+local function locals() local x, y = 10, 20 return pair(x + y, y) end
+print(locals())
+
+-- C functions are called normally, and their results still returned.
+local function to_string(v) return tostring(v) end
+print(to_string(42), type(to_string(nil)))
+
+-- Upvalues of the tail calling frame are closed before it is replaced.
+local function make(n)
+    local captured = n
+    local function get() return captured end
+    return pair(get, n)
+end
+local get, n = make(7)
+print(get(), n)
+
+-- Parentheses truncate to 1 result, so this is not a tail call.
+local function one() return (pair(1, 2)) end
+print(one())
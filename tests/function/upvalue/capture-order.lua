@@ -0,0 +1,33 @@
+-- Locals captured in any order, and by more than one closure, must each
+-- share one upvalue for as long as they are open.
+local function make()
+    local a, b, c, d = 1, 2, 3, 4
+    local get_d = function() return d end
+    local get_b = function() return b end
+    local get_a = function() return a end
+    local get_c = function() return c end
+    local set = function(x) a, b, c, d = x, x + 1, x + 2, x + 3 end
+    return get_a, get_b, get_c, get_d, set
+end
+
+local get_a, get_b, get_c, get_d, set = make()
+print(get_a(), get_b(), get_c(), get_d()) -- 1 2 3 4
+set(10)
+print(get_a(), get_b(), get_c(), get_d()) -- 10 11 12 13
+
+-- Lower locals captured again after higher ones, while the higher ones are
+-- still open.
+local function nested()
+    local x = 1
+    local fs = {}
+    for i = 1, 3 do
+        local y = i * 10
+        fs[i] = function() x = x + 1; return x + y end
+    end
+    local z = 100
+    local g = function() return x + z end
+    return fs, g
+end
+
+local fs, g = nested()
+print(fs[1](), fs[2](), fs[3](), g()) -- 12 23 34 104
@@ -11,6 +11,15 @@ end
 
 print(f(g()))
 
+-- Parameters not given by the variadic call are `nil`, not whatever was left
+-- in their registers.
+local function none()
+    local t, s = {}, "stale"
+    return
+end
+print(f(none()))
+print(f(1, none()))
+
 -- return f(g())
 -- return "values:", f(g())
 -- return f(g()), "cutoff"
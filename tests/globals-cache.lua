@@ -0,0 +1,21 @@
+-- `OP_GET_GLOBAL`/`OP_SET_GLOBAL` cache where they last found their key
+-- in `_G`, which must not hide later rehashes or metatables.
+local function get() return counter end
+local function set(v) counter = v end
+
+counter = 1
+print(get())
+for i = 1, 64 do
+    _G["filler" .. i] = i
+end
+set(2)
+print(get(), counter)
+
+counter = nil
+setmetatable(_G, {
+    __index    = function(t, k) return "__index " .. k end,
+    __newindex = function(t, k, v) rawset(t, k, v * 10) end,
+})
+print(get())
+set(3)
+print(get(), rawget(_G, "counter"))
@@ -0,0 +1,43 @@
+-- Integral numbers may be kept in integer form internally. None of these
+-- should be able to tell the difference.
+local t = {}
+for i = 1, 5 do
+    t[i + 1] = i * 2
+end
+print(#t, t[2], t[6], t[2.0], type(#t), type(t[2]))
+
+t[1.0] = "one"
+print(t[1], 1 == 1.0, 3 - 2 == 0.5 * 2)
+-- `1.0` and `1` must be the same key. Index explicitly, as the order of
+-- `pairs()` depends on the table layout.
+local n = 0
+for k, v in pairs(t) do
+    n = n + 1
+end
+local out = ""
+for i = 1, n do
+    out = out .. i .. "=" .. t[i] .. " "
+end
+print(n, out)
+
+-- Results that are no longer exact must round just like floats.
+local big = 2^53
+print(big + 1 == big, big - 1 + 2, (big + 2) - big)
+print(-0, 0 - 0, -0.0 + 0, 1 - 1, 2^53 + 2^53)
+
+out = ""
+for i = 3, 1, -1 do out = out .. i .. " " end
+for i = 1, 2, 0.5 do out = out .. i .. " " end
+for i = 0.5, 2 do out = out .. i .. " " end
+for i = 2^53 - 4, 2^53 - 2 do out = out .. (i - 2^53) .. " " end
+print(out)
+
+local s = 0
+for i = 1, 100 do
+    s = s + i
+end
+print(s, s / 2, s % 7, "" .. s, string.format("%d %s", s, s))
+
+local a, b = 0, -7
+print(a * b, b * a, 3 * b, 2^26 * 2^26, 2^27 * 2^27 - 1)
+print(a < b, b < a, a <= 0, b <= -7.5, 1 < 1.5)
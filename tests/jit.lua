@@ -0,0 +1,190 @@
+-- Every loop here runs long enough for its function to be compiled to native
+-- code partway through, so the results must be the same either way. Compare
+-- with `LULU_JIT=0`.
+local N = 300
+
+-- Integer form overflows into number form past 2^53.
+local function sums(start, step)
+    local x = start
+    for _ = 1, N do
+        x = x + step
+    end
+    return x
+end
+print(sums(0, 1), sums(9007199254740000, 7), sums(-9007199254740000, -7))
+print(sums(0.25, 0.5), sums(1, 1e300), sums(0, -0.0))
+
+local function products()
+    local a, b, c = 1, 1, 0
+    for i = 1, N do
+        a = (a * 3) % 1000003
+        b = b * -1            -- Stays in integer form.
+        c = 0 * -i            -- `-0` has no integer form.
+    end
+    local big = 67108864 -- 2^26
+    return a, b, c, big * big, big * (big + 1), 1 / c
+end
+print(products())
+
+local function mixed()
+    local n, f, d, u = 0, 0.5, 0, 0
+    for i = 1, N do
+        n = n + i * 2 - i
+        f = f + i / 4
+        d = i / 0
+        u = -i + -f
+    end
+    return n, f, d, u, -(0)
+end
+print(mixed())
+
+-- Float loops, including those with integer limits and negative steps.
+local function float_loops()
+    local t = {}
+    for i = 1, 10, 0.5 do t[#t + 1] = i end
+    for i = 10, 1, -2.5 do t[#t + 1] = i end
+    for i = 0.1, 0.35, 0.05 do t[#t + 1] = i end
+    for i = 3, 1, -1 do t[#t + 1] = i end
+    return #t, t[1], t[2], t[19], t[20], t[24], t[#t]
+end
+for _ = 1, N do float_loops() end
+print(float_loops())
+
+-- Comparisons, including NaN and mixed integer/number operands.
+local function compare(a, b)
+    local r = ""
+    for _ = 1, 2 do
+        r = (a < b and "<" or "") .. (a <= b and "=" or "")
+            .. (a == b and "e" or "") .. (a ~= b and "n" or "")
+            .. (not (a < b) and "!" or "")
+    end
+    return r
+end
+local nan = 0/0
+local pairs_ = {{1, 2}, {2, 1}, {2, 2}, {2, 2.0}, {2.5, 2}, {nan, 1}, {1, nan},
+    {nan, nan}, {-0.0, 0}, {-1, -1.5}}
+for _ = 1, N do
+    for i = 1, #pairs_ do compare(pairs_[i][1], pairs_[i][2]) end
+end
+local results = {}
+for i = 1, #pairs_ do
+    results[i] = compare(pairs_[i][1], pairs_[i][2])
+end
+print(table.concat(results, " "))
+
+-- Raw equality of every type.
+local function equal(a, b)
+    local n = 0
+    for _ = 1, N do
+        if a == b then n = n + 1 end
+    end
+    return n
+end
+local t1, t2 = {}, {}
+print(equal(nil, nil), equal(nil, false), equal(true, true), equal(true, false),
+    equal("x", "x"), equal("x", "y"), equal(t1, t1), equal(t1, t2),
+    equal(print, print), equal(1, "1"), equal(3, 3.0), equal(nan, nan))
+
+-- Truthiness, `and`/`or` and `not`.
+local function logic(v)
+    local a, b, c, d
+    for _ = 1, N do
+        a = v and 1 or 2
+        b = v or "default"
+        c = not v
+        d = not not v
+    end
+    return a, b, c, d
+end
+print(logic(nil), logic(false))
+print(logic(0), logic(""))
+
+-- Upvalues, both open and closed.
+local function counter()
+    local count = 0
+    return function(n)
+        for _ = 1, n do
+            count = count + 1
+        end
+        return count
+    end
+end
+local c1, c2 = counter(), counter()
+print(c1(N), c2(5), c1(N))
+
+local shared = 0
+for _ = 1, N do
+    shared = shared + 1
+end
+print(shared)
+
+-- Array reads and writes, including holes, the hash segment and
+-- metamethods which the native code must leave to the interpreter.
+local function arrays(t, n)
+    local s = 0
+    for i = 1, n do
+        t[i] = i * 2
+    end
+    for i = 1, n + 5 do
+        local v = t[i]
+        if v then s = s + v end
+    end
+    t[2] = nil
+    return s, t[1], t[2], t[n], t[n + 1]
+end
+print(arrays({}, N))
+print(arrays({1, 2, 3}, N))
+local logged = 0
+local proxy = setmetatable({}, {
+    __index = function(_, k) return -k end,
+    __newindex = function(t, k, v) logged = logged + 1; rawset(t, k, v) end,
+})
+print(arrays(proxy, N), logged)
+local fixed = {1, 2, 3, 4, 5}
+local fs = 0
+for _ = 1, N do
+    for i = 1, 5 do
+        fs = fs + fixed[i]
+        fixed[i] = fixed[i]
+    end
+end
+print(fs, fixed[1.0], fixed[2.5], fixed["1"])
+
+-- Operands of the wrong type still reach their metamethods or errors.
+local V = {}
+V.__add = function(a, b) return "add" end
+V.__lt  = function(a, b) return true end
+local v = setmetatable({}, V)
+local r1, r2, r3, r4
+for i = 1, N do
+    r1 = v + i
+    r2 = -"3"
+    r3 = v < v
+    r4 = "10" + i
+end
+print(r1, r2, r3, r4)
+
+-- Calls in the middle of a hot loop leave native code and come back.
+local function id(x) return x end
+local total = 0
+for i = 1, N do
+    total = total + id(i) * 2
+    if i % 100 == 0 then
+        total = total - tostring(i):len()
+    end
+end
+print(total)
+
+-- Remainders of integral values, except for those which are `-0` or NaN.
+local function remainders(a, b)
+    local r
+    for _ = 1, N do
+        r = a % b
+    end
+    return r
+end
+print(remainders(7, 3), remainders(-7, 3), remainders(7, -3), remainders(-6, 3),
+    remainders(6, 0), remainders(7.5, 2), remainders(0, 5))
+print(remainders(7.0, 2), remainders(-6.0, 3), remainders(-0.0, 3),
+    remainders(5, -0.0), remainders(2^60, 3), remainders(7, 1/0),
+    remainders(nan, 2))
@@ -0,0 +1,25 @@
+-- Conditions which only test a register compile to a single jump, in both
+-- senses, including when the jump goes backwards in `repeat ... until`.
+local x, y = 1, nil
+if x then print("x") end
+if not x then print("unreachable") else print("not not x") end
+if y then print("unreachable") elseif not y then print("not y") end
+
+local n = 0
+while x do
+    n = n + 1
+    if n == 3 then x = nil end
+end
+print("while", n)
+
+local done
+repeat
+    n = n - 1
+    done = n == 0 or nil
+until done
+print("repeat", n)
+
+-- Only the last test of an `and` or `or` is fused.
+local a, b = false, "b"
+if a or b then print("a or b") end
+if a and b then print("unreachable") end
@@ -0,0 +1,42 @@
+-- Calls to `math.abs()`, `math.floor()` and so on are run inline when their
+-- arguments are numbers. Everything else must behave as an ordinary call.
+local nan = 0/0
+print(math.abs(-3), math.abs(2.5), math.abs(-0.0), math.abs(-1/0))
+print(math.floor(3.7), math.floor(-3.2), math.floor(4), math.floor(2^60 + 0.5))
+print(math.ceil(3.2), math.ceil(-3.7), math.ceil(4), math.ceil(-0.5))
+print(math.sqrt(16), math.sqrt(2), math.sqrt(-1) ~= math.sqrt(-1))
+print(math.max(1), math.max(1, 5), math.max(5, 1), math.max(3, 9, 2, 8))
+print(math.min(1), math.min(1, 5), math.min(5, 1), math.min(3, 9, 2, 8))
+print(math.max(nan, 1) ~= math.max(nan, 1), math.max(1, nan))
+
+-- Results are adjusted like any other call's.
+local a, b, c = math.floor(1.5)
+print(a, b, c)
+local t = {math.abs(-1), math.floor(2.5), math.min(9, 3), 0}
+print(#t, t[1], t[2], t[3])
+print((math.max(1, 2)), math.floor(1.5) + 1)
+
+-- Variadic arguments are always left to the call.
+local function three() return 4, 7, 1 end
+print(math.max(three()), math.min(0.5, three()), math.floor(three()))
+
+-- Strings are converted by the call, not inline.
+print(math.floor("3.5"), math.max("2", 10), math.abs(" -4 "))
+
+-- Only the real functions are run inline, whatever the field is named.
+local m = {floor = function(x) return "floor " .. x end, abs = print}
+print(m.floor(1.5))
+local floor = math.floor
+math.floor = function(x) return "patched " .. x end
+print(math.floor(1.5), floor(1.5))
+math.floor = floor
+print(math.floor(1.5))
+
+local function tail(x) return math.ceil(x) end
+print(tail(1.5))
+
+local s = 0
+for i = 1, 1000 do
+    s = s + math.floor(i / 3) + math.max(i % 7, 3) - math.min(i, 500)
+end
+print(s)
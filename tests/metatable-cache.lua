@@ -0,0 +1,47 @@
+-- Metatables remember which metamethods they lack. Setting one afterwards, in
+-- any way, must still be noticed.
+local mt = {}
+local t = setmetatable({}, mt)
+local u = setmetatable({}, mt)
+
+-- Each of these looks up a metamethod which is not there yet.
+print(t.x, #t)
+
+-- New key.
+mt.__index = function(_, k) return "index " .. k end
+print(t.x)
+
+-- Existing key whose value was `nil`, which is assigned in place.
+mt.__index = nil
+print(t.x)
+mt.__index = function(_, k) return "again " .. k end
+print(t.x)
+
+-- `rawset()`.
+rawset(mt, "__len", function() return 42 end)
+print(#t)
+
+-- Arithmetic, comparison and unary minus, which are looked up on both sides.
+for _, name in ipairs({"__add", "__sub", "__mul", "__div", "__mod", "__pow",
+    "__unm", "__lt", "__le"})
+do
+    mt[name] = function() return name end
+end
+print(t + 1, 1 - t, t * t, t / 2, t % 2, 2 ^ t, -t)
+print(t < u, t <= u)
+
+-- One metatable shared by another, whose cache is separate.
+local mt2 = {__index = mt}
+local v = setmetatable({}, mt2)
+print(v.__add ~= nil, v.__concat)
+mt.__concat = "concat"
+print(v.__concat)
+
+-- Metatables of other types, e.g. strings.
+local smt = getmetatable("")
+print(smt ~= nil)
+if smt then
+    smt.__unm = function(s) return "-" .. s end
+    print(-"abc", -"3")
+    smt.__unm = nil
+end
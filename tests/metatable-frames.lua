@@ -0,0 +1,77 @@
+-- Lua metamethods and generic `for` generators run in frames of their own,
+-- rather than recursing in C. Each instruction must still get their results.
+local V = {}
+V.__index = function(t, k) return k .. "!" end
+V.__newindex = function(t, k, v) rawset(t, k, v * 2) end
+V.__add = function(a, b) return "add" end
+V.__unm = function(a) return "unm" end
+V.__len = function(a) return 7 end
+V.__lt  = function(a, b) return rawget(a, "n") < rawget(b, "n") end
+V.__le  = function(a, b) return rawget(a, "n") <= rawget(b, "n") end
+
+local a = setmetatable({n = 1}, V)
+local b = setmetatable({n = 2}, V)
+print(a.x, a["y"], a + 1, 1 + a, -a, #a)
+print(a < b, b < a, a <= b, b <= a)
+if b < a then print("wrong") else print("right") end
+
+a.z = 21
+print(rawget(a, "z"))
+
+-- Methods, and globals when `_G` has `__index`.
+V.__index = {get = function(self) return self.n end}
+print(a:get(), b:get())
+setmetatable(_G, {__index = function(t, k) return "global " .. k end})
+print(undefined_name)
+setmetatable(_G, nil)
+
+-- Too deep for the C call limit, but not for the call frame limit.
+local chain = setmetatable({}, {__index = function(t, k)
+    if k == 0 then
+        return "bottom"
+    end
+    return t[k - 1]
+end})
+print(chain[1000])
+
+-- Generators written in Lua, including one that tail calls.
+local function range(n)
+    return function(_, i)
+        if i < n then
+            return i + 1
+        end
+    end, nil, 0
+end
+local sum = 0
+for i in range(100) do
+    sum = sum + i
+end
+print(sum)
+
+local function step(_, i)
+    if i < 3 then
+        return i + 1, i * 10
+    end
+end
+local function tail_step(s, i)
+    return step(s, i)
+end
+for i, v in tail_step, nil, 0 do
+    print(i, v)
+end
+
+-- Metamethods that quicken the very instruction which called them, by running
+-- it again with numbers. It must still be finished as the generic one.
+local function add(x, y) return x + y end
+local function lt(x, y) return x < y end
+local Q = {}
+Q.__add = function(x, y) return add(1, 2) end
+Q.__lt  = function(x, y) return lt(1, 2) end
+local q = setmetatable({}, Q)
+print(add(q, 1), add(1, q))
+print(lt(q, q), lt(q, q) and "yes" or "no")
+
+-- Errors in metamethods still unwind properly.
+local E = setmetatable({}, {__index = function(t, k) error("no " .. k) end})
+print(pcall(function() return E.key end))
+print(a.n, b.n)
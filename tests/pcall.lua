@@ -0,0 +1,50 @@
+-- Errors are caught by `pcall()`, which returns them as its second result.
+local function divide(a, b)
+    if b == 0 then
+        error("division by zero")
+    end
+    return a / b
+end
+
+print(pcall(divide, 1, 2))
+print(pcall(divide, 1, 0))
+print(pcall(error, "no position", 0))
+print(pcall(string.rep))
+
+-- Runtime errors keep the line they were raised on.
+local t
+print(pcall(function() return t.x end))
+print(pcall(function(a, b) return a + b end, 1, {}))
+
+-- Only the status is used here, so the message is never made.
+local n = 0
+for i = 1, 10 do
+    if not pcall(divide, i, i % 2) then
+        n = n + 1
+    end
+end
+print("failed", n)
+pcall(error, "discarded")
+
+-- The stack and upvalues are intact after a caught error.
+local function counter()
+    local count = 0
+    return function()
+        count = count + 1
+        if count % 2 == 0 then error("even") end
+        return count
+    end
+end
+local c = counter()
+for _ = 1, 4 do
+    print(pcall(c))
+end
+local ok = pcall(c)
+print(ok, pcall(c))
+
+-- Nested `pcall()`, and errors in the error handler's caller.
+print(pcall(pcall, error, "inner"))
+print(pcall(function()
+    local ok, msg = pcall(error, "first")
+    error(msg .. ", then second", 0)
+end))
@@ -0,0 +1,44 @@
+-- Each call site below first sees numbers (and gets quickened), then sees
+-- other types, which must make it fall back to the generic opcode.
+local function add(a, b) return a + b end
+local function lt(a, b) return a < b end
+local function get(t, k) return t[k] end
+local function set(t, k, v) t[k] = v end
+
+local V = {}
+V.__add = function(a, b) return "__add" end
+V.__lt  = function(a, b) return true end
+V.__index = function(t, k) return "__index " .. tostring(k) end
+
+for i = 1, 3 do
+    print(add(i, 1), lt(i, 2))
+end
+print(add("1", 2), add(setmetatable({}, V), 1))
+print(lt(setmetatable({}, V), setmetatable({}, V)))
+print(add(2, 3), lt(1, 2))
+
+local t = {10, 20, 30, x = "x"}
+for i = 1, 4 do
+    print(get(t, i))
+end
+print(get(t, "x"), get(t, "y"), get(t, 1.5))
+
+local u = setmetatable({1, nil, 3}, V)
+print(get(u, 1), get(u, 2), get(u, "y"))
+
+for i = 1, 3 do
+    set(t, i, i * 2)
+end
+set(t, 4, 8)
+set(t, "x", "y")
+print(t[1], t[2], t[3], t[4], t.x, #t)
+
+local log = {}
+local w = setmetatable({1, nil}, {__newindex = function(t, k, v)
+    log[#log + 1] = k
+    rawset(t, k, v)
+end})
+set(w, 1, "a")
+set(w, 2, "b")
+set(w, 2, "c")
+print(w[1], w[2], #log, log[1])
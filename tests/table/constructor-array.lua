@@ -0,0 +1,43 @@
+-- Array items in constructors are flushed in blocks of 50 (FIELDS_PER_FLUSH).
+local function range(n)
+    if n == 0 then
+        return
+    end
+    return n, range(n - 1)
+end
+
+local function check(t, n, label)
+    assert(#t == n, label)
+    for i = 1, n do
+        assert(t[i] == n - i + 1, label)
+    end
+end
+
+-- Variadic items grow the array past what `OP_NEW_TABLE` reserved.
+check({range(0)},   0,   "empty")
+check({range(7)},   7,   "single")
+check({range(120)}, 120, "variadic")
+
+-- Fixed items in more than one flush followed by variadic ones.
+local t = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+    11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+    31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50,
+    51, 52, range(3),
+}
+assert(#t == 55)
+for i = 1, 52 do
+    assert(t[i] == i)
+end
+assert(t[53] == 3 and t[54] == 2 and t[55] == 1)
+
+-- Explicit integer keys are overwritten by positional ones, as in Lua.
+t = {[1] = "x", [60] = "y", range(60)}
+check(t, 60, "keyed")
+
+-- Hash items survive the array growing.
+t = {a = 1, b = 2, range(80)}
+check(t, 80, "mixed")
+assert(t.a == 1 and t.b == 2)
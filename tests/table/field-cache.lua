@@ -0,0 +1,37 @@
+-- Each `p.x`/`p.y` site below caches where it last found its key, so give
+-- it tables with different layouts, rehashes and metatables.
+local function get(p) return p.x, p.y end
+local function set(p, x) p.x = x end
+
+local a = {x = 1, y = 2}
+local b = {y = 3, x = 4, z = 5}
+local c = {a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8, x = 9}
+for _ = 1, 2 do
+    print(get(a))
+    print(get(b))
+    print(get(c))
+    print(get({}))
+end
+
+-- Grow `a` so that it gets rehashed and the cached index goes stale.
+for i = 1, 20 do
+    a["k" .. i] = i
+end
+set(a, 10)
+print(get(a))
+
+-- Fields that were set to `nil` must still see `__index` and `__newindex`.
+local log = {}
+local mt = {
+    __index    = function(t, k) return "__index " .. k end,
+    __newindex = function(t, k, v) log[#log + 1] = k .. "=" .. tostring(v) end,
+}
+local d = setmetatable({x = 1, y = 2}, mt)
+print(get(d))
+d.x = nil
+print(get(d))
+set(d, 30)
+print(get(d), log[1])
+rawset(d, "x", 40)
+set(d, 50)
+print(get(d), #log)
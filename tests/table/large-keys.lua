@@ -0,0 +1,6 @@
+-- Integral keys outside of the array index range must never alias any
+-- valid array index.
+local t = {1, 2, 3}
+t[2^32 + 1] = "big"
+t[-(2^32) + 2] = "small"
+print(t[1], t[2], t[2^32 + 1], t[-(2^32) + 2], #t)